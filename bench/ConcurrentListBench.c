@@ -0,0 +1,235 @@
+/**
+ * @file ConcurrentListBench.c
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Measures ConcurrentList throughput as the number of threads grows
+ *
+ * Every thread runs the same mix of inserts, removes and contains over a shared
+ * range of keys, half of which are present to begin with. Each mix is run on the
+ * ConcurrentList and on the setup it replaces: a List kept with 'insertSortedList'
+ * behind one global mtx_t. Usage: ConcurrentListBench [maxThreads], which
+ * defaults to the number of online CPUs
+ **/
+
+#define _DEFAULT_SOURCE
+
+#include "ConcurrentListAPI.h"
+#include "LinkedListAPI.h"
+
+#include <threads.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_KEYS 512
+#define BENCH_OPERATIONS 400000
+
+/**
+ * Percentages of contains and inserts in a mix; the rest are removes
+ **/
+typedef struct BenchMix {
+    const char * name;
+    unsigned int contains;
+    unsigned int inserts;
+} BenchMix;
+
+typedef struct BenchThread {
+    ConcurrentList * concurrent;
+    List * locked;
+    mtx_t * lock;
+    const BenchMix * mix;
+    size_t operations;
+    unsigned int seed;
+} BenchThread;
+
+static double now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*xorshift32; rand() is not required to be thread safe*/
+static unsigned int nextRandom(unsigned int * state) {
+    unsigned int x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return *state = x;
+}
+
+static char * printInt(void * data) {
+    char * str = malloc(sizeof(char) * 16);
+    if (str) {
+        sprintf(str, "%d ", *(int *)data);
+    }
+    return str;
+}
+
+static int compareInt(const void * a, const void * b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+
+    return (x > y) - (x < y);
+}
+
+static int * createInt(int value) {
+    int * data = malloc(sizeof(int));
+    if (data) {
+        *data = value;
+    }
+    return data;
+}
+
+static int runConcurrent(void * arg) {
+    BenchThread * thread = arg;
+
+    for (size_t i = 0; i < thread->operations; ++i) {
+        unsigned int random = nextRandom(&thread->seed);
+        int key = (int)(random % BENCH_KEYS);
+        unsigned int roll = (random >> 16) % 100;
+
+        if (roll < thread->mix->contains) {
+            concurrentListContains(thread->concurrent, &key);
+        } else if (roll < thread->mix->contains + thread->mix->inserts) {
+            int * data = createInt(key);
+            if (data && insertConcurrentList(thread->concurrent, data) != EXIT_SUCCESS) {
+                free(data);
+            }
+        } else {
+            removeFromConcurrentList(thread->concurrent, &key);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*The same operations with set semantics on the List, every one of them holding the global lock*/
+static int runLocked(void * arg) {
+    BenchThread * thread = arg;
+
+    for (size_t i = 0; i < thread->operations; ++i) {
+        unsigned int random = nextRandom(&thread->seed);
+        int key = (int)(random % BENCH_KEYS);
+        unsigned int roll = (random >> 16) % 100;
+
+        mtx_lock(thread->lock);
+        if (roll < thread->mix->contains) {
+            listContains(thread->locked, &key);
+        } else if (roll < thread->mix->contains + thread->mix->inserts) {
+            if (!listContains(thread->locked, &key)) {
+                int * data = createInt(key);
+                if (data && insertSortedList(thread->locked, data) != EXIT_SUCCESS) {
+                    free(data);
+                }
+            }
+        } else {
+            removeFromList(thread->locked, &key);
+        }
+        mtx_unlock(thread->lock);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*Runs the mix on 'threads' threads, splitting BENCH_OPERATIONS between them, and returns operations per second*/
+static double runMix(size_t threads, const BenchMix * mix, bool concurrent) {
+    ConcurrentList * concurrentList = NULL;
+    List * lockedList = NULL;
+    mtx_t lock;
+
+    if (concurrent) {
+        concurrentList = createConcurrentList(printInt, free, compareInt);
+    } else {
+        lockedList = createList(printInt, free, compareInt);
+    }
+    if ((!concurrentList && !lockedList) || mtx_init(&lock, mtx_plain) != thrd_success) {
+        return 0.0;
+    }
+
+    /*Start with every other key present, the balance an even mix of inserts and removes settles at*/
+    for (int key = 0; key < BENCH_KEYS; key += 2) {
+        int * data = createInt(key);
+        if (concurrent) {
+            insertConcurrentList(concurrentList, data);
+        } else {
+            insertListBack(lockedList, data);
+        }
+    }
+
+    thrd_t * handles = malloc(sizeof(thrd_t) * threads);
+    BenchThread * args = malloc(sizeof(BenchThread) * threads);
+    if (!handles || !args) {
+        free(handles);
+        free(args);
+        return 0.0;
+    }
+
+    double start = now();
+    size_t started = 0;
+    for (size_t i = 0; i < threads; ++i) {
+        args[i].concurrent = concurrentList;
+        args[i].locked = lockedList;
+        args[i].lock = &lock;
+        args[i].mix = mix;
+        args[i].operations = BENCH_OPERATIONS / threads;
+        args[i].seed = 2463534242u + (unsigned int)i * 7919u;
+        if (thrd_create(&handles[i], concurrent ? runConcurrent : runLocked, &args[i]) != thrd_success) {
+            break;
+        }
+        started++;
+    }
+    for (size_t i = 0; i < started; ++i) {
+        thrd_join(handles[i], NULL);
+    }
+    double elapsed = now() - start;
+
+    if (concurrent) {
+        destroyConcurrentList(concurrentList);
+    } else {
+        destroyList(lockedList);
+    }
+    mtx_destroy(&lock);
+    free(handles);
+    free(args);
+
+    return started == threads ? BENCH_OPERATIONS / threads * threads / elapsed : 0.0;
+}
+
+int main(int argc, char ** argv) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t maxThreads = argc > 1 ? strtoul(argv[1], NULL, 10) : (size_t)(cpus > 0 ? cpus : 1);
+    if (maxThreads == 0) {
+        maxThreads = 1;
+    }
+
+    BenchMix mixes[] = {
+        { "read mostly (90% contains, 5% insert, 5% remove)", 90, 5 },
+        { "update heavy (50% contains, 25% insert, 25% remove)", 50, 25 },
+    };
+
+    printf("%ld online CPUs, %d operations per run over %d keys\n", cpus, BENCH_OPERATIONS, BENCH_KEYS);
+
+    for (size_t m = 0; m < sizeof(mixes) / sizeof(mixes[0]); ++m) {
+        printf("\n%s\n", mixes[m].name);
+        printf("%8s %16s %9s %16s %9s %9s\n", "threads", "lock-free op/s", "scaling", "locked op/s", "scaling", "ratio");
+
+        double concurrentBase = 0.0, lockedBase = 0.0;
+
+        /*Doubling from one thread, always finishing on 'maxThreads' itself*/
+        for (size_t threads = 1; threads <= maxThreads; threads = threads < maxThreads && threads * 2 > maxThreads ? maxThreads : threads * 2) {
+            double concurrent = runMix(threads, &mixes[m], true);
+            double locked = runMix(threads, &mixes[m], false);
+
+            if (threads == 1) {
+                concurrentBase = concurrent;
+                lockedBase = locked;
+            }
+
+            printf("%8zu %16.0f %8.2fx %16.0f %8.2fx %8.2fx\n", threads, concurrent, concurrent / concurrentBase,
+                locked, locked / lockedBase, concurrent / locked);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file HugePageBench.c
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Compares random HTable lookups with and without HTABLE_HUGE_PAGES
+ *
+ * Builds the same table twice with 'createTableFromArraysWithFlags', once with
+ * ordinary pages and once with HTABLE_HUGE_PAGES, and times random lookups on
+ * each. The default table of 2^23 keys spans about 256MB of buckets and nodes,
+ * far beyond what a data TLB covers with 4K pages. Data TLB misses are read
+ * from the kernel's performance counters where it allows, and the amount of
+ * memory actually backed by transparent huge pages is read from /proc.
+ * Usage: HugePageBench [keys]
+ **/
+
+#define _DEFAULT_SOURCE
+
+#include "HashTableAPI.h"
+
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#define BENCH_LOOKUPS 20000000
+
+static double now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static char * printValue(void * data) {
+    char * str = malloc(sizeof(char) * 24);
+    if (str) {
+        sprintf(str, "%p ", data);
+    }
+    return str;
+}
+
+static void keepValue(void * data) {
+    (void)data;
+}
+
+static int hashKey(size_t tableSize, int key) {
+    return (int)((uint32_t)key % tableSize);
+}
+
+/*Opens a counter of data TLB load misses for this thread; -1 if the kernel does not allow it*/
+static int openTlbCounter(void) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/*Kilobytes of this process's memory currently on transparent huge pages*/
+static long hugePageKilobytes(void) {
+    FILE * file = fopen("/proc/self/smaps_rollup", "r");
+    if (!file) {
+        return -1;
+    }
+
+    char line[256];
+    long kilobytes = -1;
+    while (fgets(line, sizeof(line), file)) {
+        if (sscanf(line, "AnonHugePages: %ld kB", &kilobytes) == 1) {
+            break;
+        }
+    }
+    fclose(file);
+
+    return kilobytes;
+}
+
+static void runTable(const char * name, int flags, const int * keys, void ** values, size_t length, const int * probes) {
+    double start = now();
+    HTable * hTable = createTableFromArraysWithFlags(keys, values, length, 1, flags, printValue, keepValue, hashKey);
+    double buildTime = now() - start;
+    if (!hTable) {
+        printf("%-10s could not be built\n", name);
+        return;
+    }
+
+    long huge = hugePageKilobytes();
+    int counter = openTlbCounter();
+    uintptr_t found = 0;
+
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(counter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    start = now();
+    for (size_t i = 0; i < BENCH_LOOKUPS; ++i) {
+        found += (uintptr_t)lookupData(hTable, probes[i]);
+    }
+    double lookupTime = now() - start;
+
+    long long misses = -1;
+    if (counter >= 0) {
+        ioctl(counter, PERF_EVENT_IOC_DISABLE, 0);
+        if (read(counter, &misses, sizeof(misses)) != sizeof(misses)) {
+            misses = -1;
+        }
+        close(counter);
+    }
+
+    printf("%-10s %10.1f %14.1f %14.1f", name, buildTime * 1e3, lookupTime / BENCH_LOOKUPS * 1e9, BENCH_LOOKUPS / lookupTime / 1e6);
+    if (misses >= 0) {
+        printf(" %14.3f", (double)misses / BENCH_LOOKUPS);
+    } else {
+        printf(" %14s", "n/a");
+    }
+    printf(" %12ld\n", huge >= 0 ? huge / 1024 : -1);
+
+    /*Keeps the lookups from being optimised away*/
+    if (found == 0) {
+        printf("no keys were found\n");
+    }
+
+    destroyTable(hTable);
+}
+
+int main(int argc, char ** argv) {
+    size_t length = argc > 1 ? strtoul(argv[1], NULL, 10) : (size_t)1 << 23;
+    if (length == 0) {
+        length = 1;
+    }
+
+    int * keys = malloc(sizeof(int) * length);
+    void ** values = malloc(sizeof(void *) * length);
+    int * probes = malloc(sizeof(int) * BENCH_LOOKUPS);
+    if (!keys || !values || !probes) {
+        fprintf(stderr, "out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    /*Multiplying by an odd constant scatters the keys without repeating any*/
+    for (size_t i = 0; i < length; ++i) {
+        keys[i] = (int)((uint32_t)i * 2654435761u);
+        values[i] = (void *)(uintptr_t)(i + 1);
+    }
+
+    uint64_t state = 88172645463325252ULL;
+    for (size_t i = 0; i < BENCH_LOOKUPS; ++i) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        probes[i] = keys[state % length];
+    }
+
+    size_t bytes = length * (sizeof(HTableNode *) + sizeof(HTableNode));
+    printf("%zu keys, about %zu MB of buckets and nodes, %d random lookups\n", length, bytes >> 20, BENCH_LOOKUPS);
+    printf("%-10s %10s %14s %14s %14s %12s\n", "pages", "build ms", "ns per lookup", "Mlookups/s", "dTLB miss/op", "THP MB");
+
+    runTable("ordinary", 0, keys, values, length, probes);
+    runTable("huge", HTABLE_HUGE_PAGES, keys, values, length, probes);
+
+    free(probes);
+    free(values);
+    free(keys);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file PriorityQueueBench.c
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Compares the PriorityQueue against a List kept with 'insertSortedList' as a timer queue
+ *
+ * Each run fills a queue with 'n' random deadlines and then measures the hold
+ * model: pop the earliest deadline and push it back a random interval later,
+ * so the queue stays at 'n' entries. The sorted List is filled by sorting up
+ * front and appending, since filling it one insert at a time is quadratic, and
+ * it is held for fewer operations because each one walks half the list.
+ * Cancelling through handles and moving deadlines earlier are measured on the
+ * PriorityQueue alone, as a List has no equivalent short of a linear search
+ **/
+
+#include "PriorityQueueAPI.h"
+#include "LinkedListAPI.h"
+
+#include <time.h>
+
+#define BENCH_RANGE ((long long)1 << 30)
+
+static unsigned long long state = 88172645463325252ULL;
+
+/*xorshift64, so every run uses the same deadlines*/
+static long long nextDeadline(void) {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+
+    return (long long)(state % BENCH_RANGE);
+}
+
+static double now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static char * printDeadline(void * data) {
+    char * str = malloc(sizeof(char) * 24);
+    if (str) {
+        sprintf(str, "%lld ", *(long long *)data);
+    }
+    return str;
+}
+
+static void keepDeadline(void * data) {
+    (void)data;
+}
+
+static int compareDeadline(const void * a, const void * b) {
+    long long x = *(const long long *)a;
+    long long y = *(const long long *)b;
+
+    return (x > y) - (x < y);
+}
+
+static int compareSlots(const void * a, const void * b) {
+    return compareDeadline(*(void * const *)a, *(void * const *)b);
+}
+
+static void runSize(size_t n) {
+    long long * deadlines = malloc(sizeof(long long) * n);
+    void ** slots = malloc(sizeof(void *) * n);
+    PQHandle * handles = malloc(sizeof(PQHandle) * n);
+    if (!deadlines || !slots || !handles) {
+        fprintf(stderr, "out of memory at %zu entries\n", n);
+        exit(EXIT_FAILURE);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        deadlines[i] = nextDeadline();
+        slots[i] = &deadlines[i];
+    }
+
+    /*Filling*/
+    double start = now();
+    PriorityQueue * pQueue = createPriorityQueue(n, printDeadline, keepDeadline, compareDeadline);
+    for (size_t i = 0; i < n; ++i) {
+        pushPriorityQueue(pQueue, slots[i], &handles[i]);
+    }
+    double pushTime = now() - start;
+
+    start = now();
+    PriorityQueue * heapified = heapifyPriorityQueue(slots, n, printDeadline, keepDeadline, compareDeadline);
+    double heapifyTime = now() - start;
+    destroyPriorityQueue(heapified);
+
+    /*Holding*/
+    size_t heapOps = 1000000;
+    start = now();
+    for (size_t i = 0; i < heapOps; ++i) {
+        long long * deadline = popPriorityQueue(pQueue);
+        *deadline += nextDeadline();
+        pushPriorityQueue(pQueue, deadline, NULL);
+    }
+    double heapHold = (now() - start) / heapOps;
+
+    /*Moving deadlines earlier and cancelling; each pop frees a handle that the push after it reissues, so the fill's handles are all still live*/
+    size_t edits = n / 10;
+    size_t moved = 0;
+    start = now();
+    for (size_t i = 0; i < edits; ++i) {
+        long long * deadline = getHandleData(pQueue, handles[i]);
+        if (deadline) {
+            *deadline /= 2;
+            decreaseKey(pQueue, handles[i], NULL);
+            moved++;
+        }
+    }
+    double decreaseTime = moved ? (now() - start) / moved : 0.0;
+
+    size_t cancelled = 0;
+    start = now();
+    for (size_t i = 0; i < edits; ++i) {
+        if (removeHandle(pQueue, handles[i]) == EXIT_SUCCESS) {
+            cancelled++;
+        }
+    }
+    double cancelTime = cancelled ? (now() - start) / cancelled : 0.0;
+    destroyPriorityQueue(pQueue);
+
+    /*The same hold model on a sorted List*/
+    for (size_t i = 0; i < n; ++i) {
+        deadlines[i] = nextDeadline();
+        slots[i] = &deadlines[i];
+    }
+    qsort(slots, n, sizeof(void *), compareSlots);
+
+    List * list = createList(printDeadline, keepDeadline, compareDeadline);
+    for (size_t i = 0; i < n; ++i) {
+        insertListBack(list, slots[i]);
+    }
+
+    size_t listOps = 100000000 / n;
+    start = now();
+    for (size_t i = 0; i < listOps; ++i) {
+        long long * deadline = getFromListFront(list);
+        removeListFront(list);
+        *deadline += nextDeadline();
+        insertSortedList(list, deadline);
+    }
+    double listHold = (now() - start) / listOps;
+    destroyList(list);
+
+    printf("%9zu %11.1f %11.1f %11.1f %11.1f %11.1f %13.1f %9.0fx\n", n, pushTime / n * 1e9, heapifyTime / n * 1e9,
+        decreaseTime * 1e9, cancelTime * 1e9, heapHold * 1e9, listHold * 1e9, listHold / heapHold);
+
+    free(handles);
+    free(slots);
+    free(deadlines);
+}
+
+int main(void) {
+    printf("All times are nanoseconds per entry or per operation\n");
+    printf("%9s %11s %11s %11s %11s %11s %13s %10s\n", "entries", "push", "heapify", "decreaseKey", "cancel", "heap hold", "sorted hold", "speedup");
+
+    for (size_t n = 10000; n <= 1000000; n *= 10) {
+        runSize(n);
+    }
+
+    return EXIT_SUCCESS;
+}
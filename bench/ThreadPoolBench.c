@@ -0,0 +1,128 @@
+/**
+ * @file ThreadPoolBench.c
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Measures ThreadPool task throughput as the number of workers grows
+ *
+ * Two workloads are run at each worker count. 'external' submits every task
+ * from the main thread, so they all pass through the pool's shared queue.
+ * 'spawned' starts one task that splits into a binary tree of tasks, each
+ * submitted by a worker, so they go onto the workers' own deques and spread
+ * by stealing. Every task does the same small amount of arithmetic. Usage:
+ * ThreadPoolBench [maxWorkers], which defaults to the number of online CPUs
+ **/
+
+#define _DEFAULT_SOURCE
+
+#include "ThreadPoolAPI.h"
+
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_WORK 256
+#define BENCH_DEPTH 18
+
+static ThreadPool * benchPool;
+static atomic_ulong completed;
+static atomic_ulong checksum;
+
+static double now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*A short dependent chain of multiplies, so the compiler cannot drop the work*/
+static void doWork(uintptr_t seed) {
+    unsigned long x = seed;
+
+    for (int i = 0; i < BENCH_WORK; ++i) {
+        x = x * 6364136223846793005UL + 1442695040888963407UL;
+    }
+
+    atomic_fetch_add_explicit(&checksum, x, memory_order_relaxed);
+    atomic_fetch_add_explicit(&completed, 1, memory_order_relaxed);
+}
+
+static void externalTask(void * arg) {
+    doWork((uintptr_t)arg);
+}
+
+/*'arg' is the depth left below this task*/
+static void spawnedTask(void * arg) {
+    uintptr_t depth = (uintptr_t)arg;
+
+    if (depth > 0) {
+        submitThreadPool(benchPool, spawnedTask, (void *)(depth - 1));
+        submitThreadPool(benchPool, spawnedTask, (void *)(depth - 1));
+    }
+
+    doWork(depth);
+}
+
+static double runExternal(size_t workers, size_t tasks) {
+    benchPool = createThreadPool(workers);
+    if (!benchPool) {
+        return 0.0;
+    }
+    atomic_store(&completed, 0);
+
+    double start = now();
+    for (size_t i = 0; i < tasks; ++i) {
+        submitThreadPool(benchPool, externalTask, (void *)(uintptr_t)i);
+    }
+    waitThreadPool(benchPool);
+    double elapsed = now() - start;
+
+    destroyThreadPool(benchPool);
+
+    return atomic_load(&completed) / elapsed;
+}
+
+static double runSpawned(size_t workers) {
+    benchPool = createThreadPool(workers);
+    if (!benchPool) {
+        return 0.0;
+    }
+    atomic_store(&completed, 0);
+
+    double start = now();
+    submitThreadPool(benchPool, spawnedTask, (void *)(uintptr_t)BENCH_DEPTH);
+    waitThreadPool(benchPool);
+    double elapsed = now() - start;
+
+    destroyThreadPool(benchPool);
+
+    return atomic_load(&completed) / elapsed;
+}
+
+int main(int argc, char ** argv) {
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t maxWorkers = argc > 1 ? strtoul(argv[1], NULL, 10) : (size_t)(cpus > 0 ? cpus : 1);
+    if (maxWorkers == 0) {
+        maxWorkers = 1;
+    }
+
+    size_t tasks = ((size_t)2 << BENCH_DEPTH) - 1;
+
+    printf("%ld online CPUs, %zu tasks of %d multiplies per run\n", cpus, tasks, BENCH_WORK);
+    printf("%8s %16s %9s %16s %9s\n", "workers", "external task/s", "scaling", "spawned task/s", "scaling");
+
+    double externalBase = 0.0, spawnedBase = 0.0;
+
+    /*Doubling from one worker, always finishing on 'maxWorkers' itself*/
+    for (size_t workers = 1; workers <= maxWorkers; workers = workers < maxWorkers && workers * 2 > maxWorkers ? maxWorkers : workers * 2) {
+        double external = runExternal(workers, tasks);
+        double spawned = runSpawned(workers);
+
+        if (workers == 1) {
+            externalBase = external;
+            spawnedBase = spawned;
+        }
+
+        printf("%8zu %16.0f %8.2fx %16.0f %8.2fx\n", workers, external, external / externalBase, spawned, spawned / spawnedBase);
+    }
+
+    return atomic_load(&checksum) == 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file ConcurrentListAPI.h
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Function definitions for a lock-free sorted linked list used as an ordered set
+ **/
+
+#ifndef CONCURRENT_LIST_API
+#define CONCURRENT_LIST_API
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <assert.h>
+
+/**
+ * Number of hazard pointers each thread needs while walking a ConcurrentList
+ **/
+#define CONCURRENT_LIST_HAZARDS 3
+
+/**
+ * Structure for a ConcurrentListNode element in a ConcurrentList
+ * Member 'data' is a pointer to an arbirtary piece of data
+ * Member 'next' is a pointer to the next node; its lowest bit is set once this node has been logically removed
+ * Member 'retiredNext' is a pointer to the next node waiting to be freed once this node has been unlinked
+ **/
+typedef struct ConcurrentListNode {
+	void * data;
+	_Atomic(uintptr_t) next;
+	struct ConcurrentListNode * retiredNext;
+} ConcurrentListNode;
+
+/**
+ * Structure for a HazardRecord, claimed by one thread for the duration of an operation
+ * Member 'hazards' are the nodes the owning thread is currently reading and that must not be freed
+ * Member 'active' is true while a thread owns the record
+ * Member 'next' is a pointer to the next HazardRecord of the list
+ * Member 'retired' is a pointer to the first removed node waiting until no thread holds a hazard on it
+ * Member 'retiredCount' is the number of nodes waiting in 'retired'
+ **/
+typedef struct HazardRecord {
+	_Atomic(ConcurrentListNode *) hazards[CONCURRENT_LIST_HAZARDS];
+	atomic_bool active;
+	struct HazardRecord * next;
+	ConcurrentListNode * retired;
+	size_t retiredCount;
+} HazardRecord;
+
+/**
+ * Structure for a ConcurrentList. Elements are kept sorted and unique by 'compareData'
+ * Member 'head' is a pointer to the first ConcurrentListNode in the list
+ * Member 'length' is used to keep track of the number of elements in the list
+ * Member 'records' is a pointer to the first HazardRecord, one or more per thread that has used the list
+ * Member 'recordCount' is the number of HazardRecords allocated
+ * Member 'printData' is a function pointer to convert a piece of data into a string
+ * Member 'destroyData' is a function pointer to destroy a piece of data
+ * Member 'compareData' is a function pointer to compare to pieces of data
+ **/
+typedef struct ConcurrentList {
+	_Atomic(uintptr_t) head;
+	atomic_size_t length;
+	_Atomic(HazardRecord *) records;
+	atomic_size_t recordCount;
+	char * (*printData)(void * data);
+	void (*destroyData)(void * data);
+	int (*compareData)(const void * a, const void * b);
+} ConcurrentList;
+
+/**
+ * Function to create a new ConcurrentList data structure. The function pointers passed to the
+ * function tell the ConcurrentList how to deal with the arbitrary data it will be storing
+ * @param 'printData' returns a string representing its 'data' parameter
+ * @param 'destroyData' destroys the 'data' parameter passed to it
+ * @param 'compareData' compares two sets of arbitrary data for ordering
+ * @return A newly allocated ConcurrentList structure pointer with the appropriate function pointers; NULL on failure
+ **/
+ConcurrentList * createConcurrentList(char * (*printData)(void * data), void (*destroyData)(void * data), int (*compareData)(const void * a, const void * b));
+
+/**
+ * Inserts an arbitrary piece of data into its sorted position in the ConcurrentList
+ * @pre May be called by many threads at once
+ * @param 'list' is a pointer to the ConcurrentList that the data will be inserted into
+ * @param 'data' is a pointer to the data to be inserted
+ * @return EXIT_SUCCESS is returned if the insertion is successful; EXIT_FAILURE on failure or if equal data is already present
+ **/
+int insertConcurrentList(ConcurrentList * list, void * data);
+
+/**
+ * Removes the element equal to 'data' from the ConcurrentList. Its data is destroyed
+ * once no other thread can still be reading it
+ * @pre May be called by many threads at once
+ * @param 'list' is a pointer to the ConcurrentList to remove the data from
+ * @param 'data' is a pointer to data equal to the element to be removed
+ * @return EXIT_SUCCESS is returned if the removal is successful; EXIT_FAILURE on failure
+ **/
+int removeFromConcurrentList(ConcurrentList * list, void * data);
+
+/**
+ * Searches for a piece of data in the ConcurrentList to see if it is contained within
+ * @pre May be called by many threads at once
+ * @param 'list' is a pointer to the ConcurrentList that will be accessed
+ * @param 'data' is a pointer to the data to be found in the list
+ * @return True if the data is found in the list; false if not found or an error occurs
+ **/
+bool concurrentListContains(ConcurrentList * list, void * data);
+
+/**
+ * Destroys the entire ConcurrentList data structure and all of its elements
+ * @pre No other thread may be accessing the ConcurrentList
+ * @param 'list' is a pointer to the ConcurrentList that will be destroyed
+ * @return EXIT_SUCCESS is returned if the destruction is successful; EXIT_FAILURE on failure
+ **/
+int destroyConcurrentList(ConcurrentList * list);
+
+/**
+ * Converts all of the items in the ConcurrentList to a human readable string
+ * @pre No other thread may be removing from the ConcurrentList
+ * @param 'list' is a pointer to the ConcurrentList that will be accessed
+ * @return A newly allocated string regardless of list length; NULL on failure
+ **/
+char * printConcurrentList(ConcurrentList * list);
+
+#endif
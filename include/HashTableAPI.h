@@ -11,12 +11,28 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <assert.h>
 
+/**
+ * Number of 64 bit words in one block of a HTableFilter; one block fills a 64 byte cache line
+ **/
+#define HTABLE_FILTER_BLOCK_WORDS 8
+
+/**
+ * Filter bits allotted per key when 'createTableFilter' is given 0
+ **/
+#define HTABLE_FILTER_BITS_PER_KEY 10
+
+/**
+ * Flag for 'createTableWithFlags' to back the bucket array and node slab with huge pages where available
+ **/
+#define HTABLE_HUGE_PAGES 0x1
+
 /**
  * Structure for a HTableNode element in a List
  * Member 'key' is the key for the current data element
- * Member 'data' is a pointer to an arbirtary piece of data
+ * Member 'data' is a pointer to an arbirtary piece of data; in an inline table it points just past the node
  * Member 'next' is a pointer to the next HTableNode in the collision list
  **/
 typedef struct HTableNode {
@@ -25,22 +41,72 @@ typedef struct HTableNode {
 	struct HTableNode * next;
 } HTableNode;
 
+/**
+ * Structure for a blocked Bloom filter placed in front of a HTable. Every key maps
+ * to a single block and sets one bit in each of the block's words, so a lookup
+ * touches exactly one cache line of the filter
+ * Member 'blocks' is a 64 byte aligned array of 'blockCount' blocks of HTABLE_FILTER_BLOCK_WORDS words
+ * Member 'blockCount' is the number of blocks in the filter
+ * Member 'bitsPerKey' is the number of filter bits allotted per key when the filter is sized
+ * Member 'capacity' is the number of keys the filter was sized for
+ * Member 'staleCount' is the number of keys removed from the table since the filter was last rebuilt
+ **/
+typedef struct HTableFilter {
+	uint64_t * blocks;
+	size_t blockCount;
+	size_t bitsPerKey;
+	size_t capacity;
+	size_t staleCount;
+} HTableFilter;
+
 /**
  * Structure for a HTable
  * Member 'size' is the size of the hash table
+ * Member 'length' is used to keep track of the number of elements in the HTable
  * Member 'table' is a dynamically allocated array of HTableNodes 
+ * Member 'filter' is a pointer to an optional HTableFilter checked before the table; NULL if not in use
+ * Member 'slab' is a single block holding the nodes built by 'createTableFromArrays'; NULL if there is none
+ * Member 'slabLength' is the number of HTableNodes in 'slab'
+ * Member 'slabUsed' is the number of nodes in 'slab' still linked into the table
+ * Member 'flags' is the set of HTABLE_ flags the table was created with
+ * Member 'valueSize' is the size in bytes of each value copied into its node; 0 if values are held by pointer
  * Member 'printData' is a function pointer to convert a piece of data into a string
- * Member 'destroyData' is a function pointer to destroy a piece of data
+ * Member 'destroyData' is a function pointer to destroy a piece of data; NULL for an inline table
  * Member 'hashData' is a function pointer to hash a piece of data
  **/
 typedef struct HTable {
 	size_t size;
+	size_t length;
 	HTableNode ** table;
+	HTableFilter * filter;
+	HTableNode * slab;
+	size_t slabLength;
+	size_t slabUsed;
+	int flags;
+	size_t valueSize;
 	char * (*printData)(void * data);
 	void (*destroyData)(void * data);
 	int (*hashData)(size_t tableSize, int key);
 } HTable;
 
+/**
+ * Structure for a summary of the state of a HTable
+ * Member 'length' is the number of elements in the HTable
+ * Member 'size' is the number of buckets in the HTable
+ * Member 'usedBuckets' is the number of buckets holding at least one element
+ * Member 'longestChain' is the number of elements in the fullest bucket
+ * Member 'filterBytes' is the memory used by the HTableFilter; 0 if there is no filter
+ * Member 'filterFalsePositiveRate' is the estimated chance that the filter passes a missing key; 1 if there is no filter
+ **/
+typedef struct HTableStats {
+	size_t length;
+	size_t size;
+	size_t usedBuckets;
+	size_t longestChain;
+	size_t filterBytes;
+	double filterFalsePositiveRate;
+} HTableStats;
+
 /**
  * Function to create a new HTableNode structure for insertion into a HTable data structure
  * @pre Parameter 'data' should exist as a preallocated item and be represented as a void pointer
@@ -60,6 +126,70 @@ HTableNode * createHTableNode(int key, void * data);
  **/
 HTable * createTable(size_t size, char * (*printData)(void * data), void (*destroyData)(void * data), int (*hashData)(size_t tableSize, int key));
 
+/**
+ * Function to create a new HTable data structure with allocation options. With HTABLE_HUGE_PAGES
+ * the bucket array is mapped from huge pages when the system has them, cutting TLB misses on
+ * random lookups in very large tables, and falls back to ordinary pages when it does not
+ * @param 'size' is the number of buckets in the table
+ * @param 'flags' is a combination of HTABLE_ flags, or 0
+ * @param 'printData' returns a string representing its 'data' parameter
+ * @param 'destroyData' destroys the 'data' parameter passed to it
+ * @param 'hashData' returns an index for where the key's data should be stored in the table
+ * @return A newly allocated HTable structure pointer with the appropriate function pointers; NULL on failure
+ **/
+HTable * createTableWithFlags(size_t size, int flags, char * (*printData)(void * data), void (*destroyData)(void * data), int (*hashData)(size_t tableSize, int key));
+
+/**
+ * Function to create a new HTable that stores fixed size values inline. Each value is copied into
+ * the same allocation as its node, so an insertion makes one allocation instead of two and a lookup
+ * reads the value from the cache line it found the key on. 'insertData' copies 'valueSize' bytes from
+ * its 'data' parameter, and 'lookupData' returns a pointer into the table that stays valid until the
+ * key is removed. Values are aligned to 8 bytes and are never passed to a destroy function
+ * @param 'size' is the number of buckets in the table
+ * @param 'valueSize' is the size in bytes of every value
+ * @param 'flags' is a combination of HTABLE_ flags, or 0
+ * @param 'printData' returns a string representing its 'data' parameter
+ * @param 'hashData' returns an index for where the key's data should be stored in the table
+ * @return A newly allocated HTable structure pointer with the appropriate function pointers; NULL on failure
+ **/
+HTable * createTableInline(size_t size, size_t valueSize, int flags, char * (*printData)(void * data), int (*hashData)(size_t tableSize, int key));
+
+/**
+ * Builds a new HTable from arrays of keys and data, sized to hold every key.
+ * The input is partitioned by bucket across 'threads' workers, each of which
+ * links its own range of buckets without locking, and every node is carved
+ * from a single allocation. Where a key repeats, the later entry wins and the
+ * earlier data is destroyed, as with repeated calls to 'insertData'. Every
+ * allocation is made before any data is touched, so on failure nothing has been
+ * destroyed and the caller still owns every value
+ * @param 'keys' is an array of the keys to be inserted
+ * @param 'values' is an array of pointers to the data for each key
+ * @param 'length' is the number of elements in 'keys' and 'values'
+ * @param 'threads' is the number of threads to build with; 0 or 1 builds on the calling thread
+ * @param 'printData' returns a string representing its 'data' parameter
+ * @param 'destroyData' destroys the 'data' parameter passed to it
+ * @param 'hashData' returns an index for where the key's data should be stored in the table
+ * @return A newly allocated HTable structure pointer containing every key; NULL on failure
+ **/
+HTable * createTableFromArrays(const int * keys, void ** values, size_t length, size_t threads, char * (*printData)(void * data), void (*destroyData)(void * data), int (*hashData)(size_t tableSize, int key));
+
+/**
+ * Builds a new HTable from arrays of keys and data as 'createTableFromArrays' does, with allocation
+ * options. With HTABLE_HUGE_PAGES both the bucket array and the node slab are backed by huge pages
+ * where available, and each page is first touched by the worker that builds its part of the table.
+ * On failure nothing has been destroyed and the caller still owns every value
+ * @param 'keys' is an array of the keys to be inserted
+ * @param 'values' is an array of pointers to the data for each key
+ * @param 'length' is the number of elements in 'keys' and 'values'
+ * @param 'threads' is the number of threads to build with; 0 or 1 builds on the calling thread
+ * @param 'flags' is a combination of HTABLE_ flags, or 0
+ * @param 'printData' returns a string representing its 'data' parameter
+ * @param 'destroyData' destroys the 'data' parameter passed to it
+ * @param 'hashData' returns an index for where the key's data should be stored in the table
+ * @return A newly allocated HTable structure pointer containing every key; NULL on failure
+ **/
+HTable * createTableFromArraysWithFlags(const int * keys, void ** values, size_t length, size_t threads, int flags, char * (*printData)(void * data), void (*destroyData)(void * data), int (*hashData)(size_t tableSize, int key));
+
 /**
  * Inserts an arbitrary piece of data into the HTable data structure
  * @pre A valid HTable structure must exist for the data to be inserted into
@@ -78,6 +208,15 @@ int insertData(HTable * hTable, int key, void * data);
  **/
 int destroyTable(HTable * hTable);
 
+/**
+ * Detaches the hash table in O(1) and destroys it and all of its elements on the shared
+ * reclamation thread, so that tearing down a large table does not stall the caller
+ * @pre A valid HTable structure must exist to be destroyed; the caller must not use it after this call
+ * @param 'hTable' is a pointer to the HTable that will be destroyed
+ * @return EXIT_SUCCESS is returned if the table was handed off or destroyed; EXIT_FAILURE on failure
+ **/
+int destroyTableAsync(HTable * hTable);
+
 /**
  * Removes the specified element from the HTable structure
  * @pre A valid HTable structure from which data will be removed from must exist
@@ -104,4 +243,31 @@ void * lookupData(HTable * hTable, int key);
  **/
 char * printTable(HTable * hTable);
 
+/**
+ * Adds a blocked Bloom filter to the HTable so that most lookups of missing keys
+ * return without touching the table. The filter is kept in step by 'insertData'
+ * and 'removeData' and is rebuilt when removals or growth make it stale
+ * @pre A valid HTable structure must exist
+ * @param 'hTable' is a pointer to the HTable that will be filtered
+ * @param 'bitsPerKey' is the number of filter bits to allot per key; 0 for HTABLE_FILTER_BITS_PER_KEY
+ * @return EXIT_SUCCESS is returned if the filter is created; EXIT_FAILURE on failure
+ **/
+int createTableFilter(HTable * hTable, size_t bitsPerKey);
+
+/**
+ * Removes the HTableFilter from the HTable, if it has one
+ * @pre A valid HTable structure must exist
+ * @param 'hTable' is a pointer to the HTable whose filter will be destroyed
+ * @return EXIT_SUCCESS is returned if the destruction is successful; EXIT_FAILURE on failure
+ **/
+int destroyTableFilter(HTable * hTable);
+
+/**
+ * Summarizes the occupancy of the HTable and the cost and accuracy of its filter
+ * @pre A valid HTable structure must exist
+ * @param 'hTable' is a pointer to the HTable that will be accessed
+ * @return A HTableStats structure describing the table; zeroed on failure
+ **/
+HTableStats getTableStats(HTable * hTable);
+
 #endif
\ No newline at end of file
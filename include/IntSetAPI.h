@@ -0,0 +1,220 @@
+/**
+ * @file IntSetAPI.h
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Function definitions for a compressed set of integers using Roaring style containers
+ **/
+
+#ifndef INT_SET_API
+#define INT_SET_API
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include <assert.h>
+
+/**
+ * Largest number of values an array container holds before it becomes a bitmap
+ **/
+#define INT_SET_ARRAY_MAX 4096
+
+/**
+ * Number of 64 bit words in a bitmap container, one bit for each of its 65536 values
+ **/
+#define INT_SET_BITMAP_WORDS 1024
+
+/**
+ * Kinds of IntSetContainer
+ * INT_SET_ARRAY holds a sorted array of values; used for sparse containers
+ * INT_SET_BITMAP holds one bit per possible value; used for dense containers
+ * INT_SET_RUN holds sorted runs of consecutive values; only produced by 'optimizeIntSet'
+ **/
+typedef enum IntSetContainerType {
+	INT_SET_ARRAY,
+	INT_SET_BITMAP,
+	INT_SET_RUN
+} IntSetContainerType;
+
+/**
+ * Structure for a run of consecutive values in a run container
+ * Member 'start' is the first value in the run
+ * Member 'length' is the number of values in the run after 'start'
+ **/
+typedef struct IntSetRun {
+	uint16_t start;
+	uint16_t length;
+} IntSetRun;
+
+/**
+ * Structure for an IntSetContainer holding every value of an IntSet that shares the same upper 16 bits
+ * Member 'key' is the upper 16 bits shared by the container's values
+ * Member 'type' is the kind of storage used by the container
+ * Member 'cardinality' is the number of values in the container
+ * Member 'count' is the number of entries used in 'array' or 'runs'
+ * Member 'capacity' is the number of entries allocated for 'array' or 'runs'
+ * Member 'array', 'bitmap' or 'runs' holds the lower 16 bits of the values, depending on 'type'
+ **/
+typedef struct IntSetContainer {
+	uint16_t key;
+	IntSetContainerType type;
+	uint32_t cardinality;
+	uint32_t count;
+	uint32_t capacity;
+	union {
+		uint16_t * array;
+		uint64_t * bitmap;
+		IntSetRun * runs;
+	};
+} IntSetContainer;
+
+/**
+ * Structure for an IntSet
+ * Member 'containers' is an array of IntSetContainers sorted by key
+ * Member 'count' is the number of containers in use
+ * Member 'capacity' is the number of containers allocated
+ * Member 'length' is used to keep track of the number of values in the IntSet
+ **/
+typedef struct IntSet {
+	IntSetContainer * containers;
+	size_t count;
+	size_t capacity;
+	size_t length;
+} IntSet;
+
+/**
+ * Structure for an IntSet iterator
+ * Member 'set' is a pointer to the IntSet
+ * Member 'container' is the index of the current container
+ * Member 'index' is the position within the current container: array index, bitmap word or run
+ * Member 'offset' is the position within the current run
+ * Member 'word' is the bits of the current bitmap word that are yet to be visited
+ **/
+typedef struct IntSetIterator {
+	IntSet * set;
+	size_t container;
+	uint32_t index;
+	uint32_t offset;
+	uint64_t word;
+} IntSetIterator;
+
+/**
+ * Function to create a new, empty IntSet data structure
+ * @return A newly allocated IntSet structure pointer; NULL on failure
+ **/
+IntSet * createIntSet(void);
+
+/**
+ * Inserts a value into the IntSet
+ * @pre A valid IntSet structure must exist for the value to be inserted into
+ * @param 'set' is a pointer to the IntSet that the value will be inserted into
+ * @param 'value' is the value to be inserted
+ * @return EXIT_SUCCESS is returned if the value is in the set afterwards; EXIT_FAILURE on failure
+ **/
+int addIntSet(IntSet * set, int value);
+
+/**
+ * Removes a value from the IntSet
+ * @pre A valid IntSet structure from which the value will be removed from must exist
+ * @param 'set' is a pointer to the IntSet to remove the value from
+ * @param 'value' is the value to be removed
+ * @return EXIT_SUCCESS is returned if the removal is successful; EXIT_FAILURE on failure
+ **/
+int removeIntSet(IntSet * set, int value);
+
+/**
+ * Searches for a value in the IntSet to see if it is contained within
+ * @pre A valid IntSet structure to be searched must exist
+ * @param 'set' is a pointer to the IntSet that will be accessed
+ * @param 'value' is the value to be found
+ * @return True if the value is found in the IntSet; false if not found or an error occurs
+ **/
+bool intSetContains(IntSet * set, int value);
+
+/**
+ * Retrieves the number of values in the IntSet
+ * @pre A valid IntSet structure must exist
+ * @param 'set' is a pointer to the IntSet that will be accessed
+ * @return The number of values in the IntSet; 0 on failure
+ **/
+size_t getIntSetCardinality(IntSet * set);
+
+/**
+ * Retrieves the number of bytes of memory used by the IntSet
+ * @pre A valid IntSet structure must exist
+ * @param 'set' is a pointer to the IntSet that will be accessed
+ * @return The number of bytes allocated for the IntSet and its containers; 0 on failure
+ **/
+size_t getIntSetMemory(IntSet * set);
+
+/**
+ * Creates a new IntSet holding every value in either of two IntSets
+ * @pre Valid IntSet structures must exist for both 'a' and 'b'
+ * @param 'a' is a pointer to the first IntSet
+ * @param 'b' is a pointer to the second IntSet
+ * @return A newly allocated IntSet structure pointer; NULL on failure
+ **/
+IntSet * unionIntSet(IntSet * a, IntSet * b);
+
+/**
+ * Creates a new IntSet holding every value in both of two IntSets
+ * @pre Valid IntSet structures must exist for both 'a' and 'b'
+ * @param 'a' is a pointer to the first IntSet
+ * @param 'b' is a pointer to the second IntSet
+ * @return A newly allocated IntSet structure pointer; NULL on failure
+ **/
+IntSet * intersectIntSet(IntSet * a, IntSet * b);
+
+/**
+ * Creates a new IntSet holding every value in 'a' that is not in 'b'
+ * @pre Valid IntSet structures must exist for both 'a' and 'b'
+ * @param 'a' is a pointer to the first IntSet
+ * @param 'b' is a pointer to the second IntSet
+ * @return A newly allocated IntSet structure pointer; NULL on failure
+ **/
+IntSet * differenceIntSet(IntSet * a, IntSet * b);
+
+/**
+ * Converts every container to whichever of array, bitmap or run storage is smallest.
+ * Best called once a set is built; adding to or removing from a run container converts it back
+ * @pre A valid IntSet structure must exist
+ * @param 'set' is a pointer to the IntSet that will be modified
+ * @return EXIT_SUCCESS is returned if the conversion is successful; EXIT_FAILURE on failure
+ **/
+int optimizeIntSet(IntSet * set);
+
+/**
+ * Destroys the entire IntSet data structure
+ * @pre A valid IntSet structure must exist to be destroyed
+ * @param 'set' is a pointer to the IntSet that will be destroyed
+ * @return EXIT_SUCCESS is returned if the destruction is successful; EXIT_FAILURE on failure
+ **/
+int destroyIntSet(IntSet * set);
+
+/**
+ * Converts all of the values in the IntSet to a human readable string in ascending order
+ * @pre A valid IntSet structure to be printed from must exist
+ * @param 'set' is a pointer to the IntSet that will be accessed
+ * @return A newly allocated string regardless of set length; NULL on failure
+ **/
+char * printIntSet(IntSet * set);
+
+/**
+ * Creates a statically allocated IntSetIterator for visiting every value of an IntSet in ascending order
+ * @pre A valid IntSet structure to be accessed for iteration must exist; the set must not be modified during iteration
+ * @param 'set' is a pointer to the IntSet that will be accessed
+ * @return A new IntSetIterator structure pointing to the smallest value; on failure, 'set' is NULL
+ **/
+IntSetIterator createIntSetIterator(IntSet * set);
+
+/**
+ * Moves the iterator to the next value in the IntSet
+ * @pre A valid IntSetIterator structure must exist
+ * @param 'iterator' the IntSetIterator structure to be modified
+ * @param 'value' receives the current value
+ * @return True if a value was produced; false once every value has been visited
+ **/
+bool intSetIterateNext(IntSetIterator * iterator, int * value);
+
+#endif
@@ -15,7 +15,7 @@
 
 /**
  * Structure for a ListNode element in a List
- * Member 'data' is a pointer to an arbirtary piece of data
+ * Member 'data' is a pointer to an arbirtary piece of data; in an inline list it points just past the node
  * Member 'prev' is a pointer to the previous ListNode in the List
  * Member 'next' is a pointer to the next ListNode in the list
  **/
@@ -30,14 +30,16 @@ typedef struct ListNode {
  * Member 'head' is a pointer to the first ListNode in the List
  * Member 'tail' is a pointer to the last ListNode in the List
  * Member 'length' is used to keep track of the length of the List
+ * Member 'valueSize' is the size in bytes of each value copied into its node; 0 if values are held by pointer
  * Member 'printData' is a function pointer to convert a piece of data into a string
- * Member 'destroyData' is a function pointer to destroy a piece of data
+ * Member 'destroyData' is a function pointer to destroy a piece of data; NULL for an inline list
  * Member 'compareData' is a function pointer to compare to pieces of data
  **/
 typedef struct List {
 	ListNode * head;
 	ListNode * tail;
 	size_t length;
+	size_t valueSize;
 	char * (*printData)(void * data);
 	void (*destroyData)(void * data);
 	int (*compareData)(const void * a, const void * b);
@@ -71,6 +73,19 @@ ListNode * createListNode(void * data);
  **/
 List * createList(char * (*printData)(void * data), void (*destroyData)(void * data), int (*compareData)(const void * a, const void * b));
 
+/**
+ * Function to create a new List that stores fixed size values inline. Each value is copied into the
+ * same allocation as its node, so an insertion makes one allocation instead of two and reading a value
+ * costs no extra pointer hop. The insert functions copy 'valueSize' bytes from their 'data' parameter,
+ * and the getters return pointers into the list that stay valid until the element is removed.
+ * Values are aligned to 8 bytes and are never passed to a destroy function
+ * @param 'valueSize' is the size in bytes of every value
+ * @param 'printData' returns a string representing its 'data' parameter
+ * @param 'compareData' compares two sets of arbitrary data for equality
+ * @return A newly allocated List structure pointer with the appropriate function pointers; NULL on failure
+ **/
+List * createListInline(size_t valueSize, char * (*printData)(void * data), int (*compareData)(const void * a, const void * b));
+
 /**
  * Inserts an arbitrary piece of data into the front of the List data structure
  * @pre A valid List structure must exist for the data to be inserted into
@@ -106,6 +121,15 @@ int insertSortedList(List * list, void * data);
  **/
 int destroyList(List * list);
 
+/**
+ * Detaches the list in O(1) and destroys it and all of its elements on the shared
+ * reclamation thread, so that tearing down a long list does not stall the caller
+ * @pre A valid List structure must exist to be destroyed; the caller must not use it after this call
+ * @param 'list' is a pointer to the List that will be destroyed
+ * @return EXIT_SUCCESS is returned if the list was handed off or destroyed; EXIT_FAILURE on failure
+ **/
+int destroyListAsync(List * list);
+
 /**
  * Removes the first element from the List structure
  * @pre A valid List structure from which data will be removed from must exist
@@ -222,4 +246,46 @@ void * listIteratePrev(ListIterator * iterator);
  **/
 int resetListIterator(ListIterator * iterator);
 
+/**
+ * Moves every node of 'src' onto the back of 'dest' in O(1), leaving 'src' empty.
+ * No nodes are allocated or freed and no data is destroyed
+ * @pre Valid List structures with the same 'valueSize' must exist for both 'dest' and 'src'
+ * @param 'dest' is a pointer to the List that will receive the nodes
+ * @param 'src' is a pointer to the List that will give up its nodes
+ * @return EXIT_SUCCESS is returned if the concatenation is successful; EXIT_FAILURE on failure
+ **/
+int listConcat(List * dest, List * src);
+
+/**
+ * Moves the iterator's current node and every node after it into a new List, which the iterator
+ * then refers to. Takes time proportional to the number of nodes moved, to keep both lengths correct
+ * @pre A valid ListIterator structure must exist
+ * @param 'iterator' is the ListIterator at the first node to be moved
+ * @return A newly allocated List holding the moved nodes, empty if the iterator is past the end; NULL on failure
+ **/
+List * listSplitAt(ListIterator * iterator);
+
+/**
+ * Moves the nodes 'first' through 'last' of 'src' into 'dest' before 'position'.
+ * No nodes are allocated or freed and no data is destroyed
+ * @pre 'first' through 'last' must be a forward range of 'src'; 'position' must be a node of 'dest' outside that range, or NULL;
+ * both lists must have the same 'valueSize'
+ * @param 'dest' is a pointer to the List that will receive the nodes
+ * @param 'position' is the node to insert the range before; NULL to append it to 'dest'
+ * @param 'src' is a pointer to the List that holds the nodes, which may be 'dest'
+ * @param 'first' is the first node to be moved
+ * @param 'last' is the last node to be moved
+ * @return EXIT_SUCCESS is returned if the splice is successful; EXIT_FAILURE on failure
+ **/
+int listSpliceRange(List * dest, ListNode * position, List * src, ListNode * first, ListNode * last);
+
+/**
+ * Moves a node to the front of its List in O(1), such as to mark it as most recently used
+ * @pre 'node' must be a node of 'list'
+ * @param 'list' is a pointer to the List that holds the node
+ * @param 'node' is the node to be moved
+ * @return EXIT_SUCCESS is returned if the move is successful; EXIT_FAILURE on failure
+ **/
+int listMoveToFront(List * list, ListNode * node);
+
 #endif
\ No newline at end of file
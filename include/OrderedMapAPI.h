@@ -0,0 +1,206 @@
+/**
+ * @file OrderedMapAPI.h
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Function definitions for an ordered map backed by a B+ tree
+ **/
+
+#ifndef ORDERED_MAP_API
+#define ORDERED_MAP_API
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <assert.h>
+
+/**
+ * Size in bytes of the cache lines nodes are aligned to
+ **/
+#define ORDERED_MAP_CACHE_LINE 64
+
+/**
+ * Maximum number of keys in a leaf node. Keeps the header and every key of a
+ * leaf within one 64 byte cache line and the whole leaf within three
+ **/
+#define ORDERED_MAP_LEAF_KEYS 14
+
+/**
+ * Maximum number of keys in an inner node. Keeps the header and every key of an
+ * inner node within two 64 byte cache lines and the whole node within six
+ **/
+#define ORDERED_MAP_INNER_KEYS 30
+
+/**
+ * Structure shared by the start of every node in an OrderedMap
+ * Member 'count' is the number of keys currently held by the node
+ * Member 'isLeaf' is true if the node is an OrderedMapLeaf
+ **/
+typedef struct OrderedMapNode {
+	int count;
+	bool isLeaf;
+} OrderedMapNode;
+
+/**
+ * Structure for an inner node of an OrderedMap
+ * Member 'header' is the common node header, which starts the node on a cache line
+ * Member 'keys' are the separator keys; every key in 'children[i + 1]' is at least 'keys[i]'
+ * Member 'children' are pointers to the child nodes
+ **/
+typedef struct OrderedMapInner {
+	_Alignas(ORDERED_MAP_CACHE_LINE) OrderedMapNode header;
+	int keys[ORDERED_MAP_INNER_KEYS];
+	OrderedMapNode * children[ORDERED_MAP_INNER_KEYS + 1];
+} OrderedMapInner;
+
+/**
+ * Structure for a leaf node of an OrderedMap
+ * Member 'header' is the common node header, which starts the node on a cache line
+ * Member 'keys' are the keys stored in the leaf in ascending order
+ * Member 'data' are pointers to the arbitrary data for each key
+ * Member 'prev' is a pointer to the previous leaf in key order
+ * Member 'next' is a pointer to the next leaf in key order
+ **/
+typedef struct OrderedMapLeaf {
+	_Alignas(ORDERED_MAP_CACHE_LINE) OrderedMapNode header;
+	int keys[ORDERED_MAP_LEAF_KEYS];
+	void * data[ORDERED_MAP_LEAF_KEYS];
+	struct OrderedMapLeaf * prev;
+	struct OrderedMapLeaf * next;
+} OrderedMapLeaf;
+
+/**
+ * Structure for an OrderedMap
+ * Member 'root' is a pointer to the root node of the tree
+ * Member 'length' is used to keep track of the number of keys in the OrderedMap
+ * Member 'printData' is a function pointer to convert a piece of data into a string
+ * Member 'destroyData' is a function pointer to destroy a piece of data
+ **/
+typedef struct OrderedMap {
+	OrderedMapNode * root;
+	size_t length;
+	char * (*printData)(void * data);
+	void (*destroyData)(void * data);
+} OrderedMap;
+
+/**
+ * Structure for an OrderedMap range iterator
+ * Member 'leaf' is a pointer to the leaf holding the next element
+ * Member 'index' is the index of the next element within 'leaf'
+ * Member 'low' is the lowest key included in the range
+ * Member 'high' is the highest key included in the range
+ * Member 'reverse' is true if the iterator walks from 'high' down to 'low'
+ **/
+typedef struct OrderedMapIterator {
+	OrderedMapLeaf * leaf;
+	int index;
+	int low;
+	int high;
+	bool reverse;
+} OrderedMapIterator;
+
+/**
+ * Function to create a new OrderedMap data structure. The function pointers passed to the
+ * function tell the OrderedMap how to deal with the arbitrary data it will be storing
+ * @param 'printData' returns a string representing its 'data' parameter
+ * @param 'destroyData' destroys the 'data' parameter passed to it
+ * @return A newly allocated OrderedMap structure pointer with the appropriate function pointers; NULL on failure
+ **/
+OrderedMap * createOrderedMap(char * (*printData)(void * data), void (*destroyData)(void * data));
+
+/**
+ * Builds a new OrderedMap from sorted input in linear time
+ * @pre 'keys' must be in strictly ascending order
+ * @param 'keys' is an array of the keys to be stored
+ * @param 'data' is an array of pointers to the data for each key
+ * @param 'length' is the number of elements in 'keys' and 'data'
+ * @param 'printData' returns a string representing its 'data' parameter
+ * @param 'destroyData' destroys the 'data' parameter passed to it
+ * @return A newly allocated OrderedMap structure pointer containing every key; NULL on failure
+ **/
+OrderedMap * bulkLoadOrderedMap(const int * keys, void ** data, size_t length, char * (*printData)(void * data), void (*destroyData)(void * data));
+
+/**
+ * Inserts an arbitrary piece of data into the OrderedMap, replacing and destroying any data already stored for 'key'
+ * @pre A valid OrderedMap structure must exist for the data to be inserted into
+ * @param 'map' is a pointer to the OrderedMap that the data will be inserted into
+ * @param 'key' is an integer representing the data to be inserted
+ * @param 'data' is a pointer to the data to be inserted
+ * @return EXIT_SUCCESS is returned if the insertion is successful; EXIT_FAILURE on failure
+ **/
+int insertOrderedMap(OrderedMap * map, int key, void * data);
+
+/**
+ * Removes the specified element from the OrderedMap structure
+ * @pre A valid OrderedMap structure from which data will be removed from must exist
+ * @param 'map' is a pointer to the OrderedMap to remove the data from
+ * @param 'key' is an integer representing the data to be removed
+ * @return EXIT_SUCCESS is returned if the removal is successful; EXIT_FAILURE on failure
+ **/
+int removeOrderedMap(OrderedMap * map, int key);
+
+/**
+ * Retrieves the specified data from the OrderedMap structure
+ * @pre A valid OrderedMap structure from which the data will be retreived from must exist
+ * @param 'map' is a pointer to the OrderedMap that will be accessed
+ * @param 'key' is an integer representing the data to be accessed
+ * @return A void pointer to the requested data; NULL on failure
+ **/
+void * lookupOrderedMap(OrderedMap * map, int key);
+
+/**
+ * Searches for a key in the OrderedMap to see if it is contained within
+ * @pre A valid OrderedMap structure to be searched must exist
+ * @param 'map' is a pointer to the OrderedMap that will be accessed
+ * @param 'key' is an integer representing the data to be found
+ * @return True if the key is found in the OrderedMap; false if not found or an error occurs
+ **/
+bool orderedMapContains(OrderedMap * map, int key);
+
+/**
+ * Destroys the entire OrderedMap data structure and all of its elements
+ * @pre A valid OrderedMap structure must exist to be destroyed
+ * @param 'map' is a pointer to the OrderedMap that will be destroyed
+ * @return EXIT_SUCCESS is returned if the destruction is successful; EXIT_FAILURE on failure
+ **/
+int destroyOrderedMap(OrderedMap * map);
+
+/**
+ * Converts all of the items in the OrderedMap to a human readable string in key order
+ * @pre A valid OrderedMap structure to be printed from must exist
+ * @param 'map' is a pointer to the OrderedMap that will be accessed
+ * @return A newly allocated string regardless of map length; NULL on failure
+ **/
+char * printOrderedMap(OrderedMap * map);
+
+/**
+ * Creates a statically allocated OrderedMapIterator over every key in ['low', 'high'] in ascending order
+ * @pre A valid OrderedMap structure to be accessed for iteration must exist; the map must not be modified during iteration
+ * @param 'map' is a pointer to the OrderedMap that will be accessed
+ * @param 'low' is the lowest key to be included, INT_MIN for no lower bound
+ * @param 'high' is the highest key to be included, INT_MAX for no upper bound
+ * @return A new OrderedMapIterator structure positioned at the first key of the range; on failure, 'leaf' is NULL
+ **/
+OrderedMapIterator createOrderedMapIterator(OrderedMap * map, int low, int high);
+
+/**
+ * Creates a statically allocated OrderedMapIterator over every key in ['low', 'high'] in descending order
+ * @pre A valid OrderedMap structure to be accessed for iteration must exist; the map must not be modified during iteration
+ * @param 'map' is a pointer to the OrderedMap that will be accessed
+ * @param 'low' is the lowest key to be included, INT_MIN for no lower bound
+ * @param 'high' is the highest key to be included, INT_MAX for no upper bound
+ * @return A new OrderedMapIterator structure positioned at the last key of the range; on failure, 'leaf' is NULL
+ **/
+OrderedMapIterator createOrderedMapReverseIterator(OrderedMap * map, int low, int high);
+
+/**
+ * Moves the iterator to the next element of its range
+ * @pre A valid OrderedMapIterator structure must exist
+ * @param 'iterator' the OrderedMapIterator structure to be modified
+ * @param 'key' receives the key of the current element; may be NULL
+ * @param 'data' receives the data of the current element; may be NULL
+ * @return True if an element was produced; false once the range is exhausted
+ **/
+bool orderedMapIterateNext(OrderedMapIterator * iterator, int * key, void ** data);
+
+#endif
@@ -0,0 +1,39 @@
+/**
+ * @file PageAllocAPI.h
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Function definitions for allocating large blocks directly from the operating system
+ **/
+
+#ifndef PAGE_ALLOC_API
+#define PAGE_ALLOC_API
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+
+/**
+ * Size in bytes of the huge pages requested; the default on x86-64 and 4K granule AArch64
+ **/
+#define PAGE_ALLOC_HUGE_PAGE_SIZE ((size_t)2 * 1024 * 1024)
+
+/**
+ * Allocates a zero filled block mapped straight from the operating system. With 'hugePages',
+ * blocks of at least one huge page first try the explicit huge page pool, then fall back to a
+ * huge page aligned mapping marked for transparent huge pages, then to ordinary pages.
+ * Pages are not touched here, so each is placed on the NUMA node of the thread that first writes it
+ * @param 'bytes' is the size of the block to be allocated
+ * @param 'hugePages' is true if huge pages should be tried
+ * @return A pointer to the newly allocated block; NULL on failure
+ **/
+void * allocatePages(size_t bytes, bool hugePages);
+
+/**
+ * Frees a block returned by 'allocatePages'
+ * @pre 'bytes' and 'hugePages' must match the call that allocated the block
+ * @param 'memory' is a pointer to the block to be freed
+ * @param 'bytes' is the size the block was allocated with
+ * @param 'hugePages' is whether huge pages were requested for the block
+ **/
+void freePages(void * memory, size_t bytes, bool hugePages);
+
+#endif
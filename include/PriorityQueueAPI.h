@@ -0,0 +1,164 @@
+/**
+ * @file PriorityQueueAPI.h
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Function definitions for an array backed 4-ary heap priority queue
+ **/
+
+#ifndef PRIORITY_QUEUE_API
+#define PRIORITY_QUEUE_API
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <assert.h>
+
+/**
+ * Number of children of every node in the heap
+ **/
+#define PQ_ARITY 4
+
+/**
+ * Value of an invalid PQHandle, returned when no handle could be issued
+ **/
+#define PQ_INVALID_HANDLE SIZE_MAX
+
+/**
+ * A stable reference to an element of a PriorityQueue. A handle remains valid
+ * until its element leaves the queue, after which it may be reissued to a new element
+ **/
+typedef size_t PQHandle;
+
+/**
+ * Structure for a PQEntry element in a PriorityQueue
+ * Member 'data' is a pointer to an arbirtary piece of data
+ * Member 'handle' is the handle that was issued for the data
+ **/
+typedef struct PQEntry {
+	void * data;
+	PQHandle handle;
+} PQEntry;
+
+/**
+ * Structure for a PriorityQueue
+ * Member 'heap' is a contiguous array of PQEntries ordered as a 4-ary min heap
+ * Member 'positions' maps every issued handle to its entry's index in 'heap'
+ * Member 'freeHandles' is a stack of handles available for reuse
+ * Member 'length' is used to keep track of the number of elements in the PriorityQueue
+ * Member 'capacity' is the number of entries allocated for 'heap'
+ * Member 'handleCount' is the number of handles that have ever been issued
+ * Member 'freeCount' is the number of handles in 'freeHandles'
+ * Member 'printData' is a function pointer to convert a piece of data into a string
+ * Member 'destroyData' is a function pointer to destroy a piece of data
+ * Member 'compareData' is a function pointer to compare to pieces of data
+ **/
+typedef struct PriorityQueue {
+	PQEntry * heap;
+	size_t * positions;
+	PQHandle * freeHandles;
+	size_t length;
+	size_t capacity;
+	size_t handleCount;
+	size_t freeCount;
+	char * (*printData)(void * data);
+	void (*destroyData)(void * data);
+	int (*compareData)(const void * a, const void * b);
+} PriorityQueue;
+
+/**
+ * Function to create a new PriorityQueue data structure. The element that compares
+ * lowest according to 'compareData' is always at the front of the queue
+ * @param 'capacity' is the number of elements to allocate room for up front
+ * @param 'printData' returns a string representing its 'data' parameter
+ * @param 'destroyData' destroys the 'data' parameter passed to it
+ * @param 'compareData' compares two sets of arbitrary data for ordering
+ * @return A newly allocated PriorityQueue structure pointer with the appropriate function pointers; NULL on failure
+ **/
+PriorityQueue * createPriorityQueue(size_t capacity, char * (*printData)(void * data), void (*destroyData)(void * data), int (*compareData)(const void * a, const void * b));
+
+/**
+ * Builds a new PriorityQueue from an array of data in linear time. The element
+ * at 'array[i]' is issued the handle 'i'
+ * @pre Every element of 'array' should exist as a preallocated item
+ * @param 'array' is an array of pointers to the data to be stored in the queue
+ * @param 'length' is the number of elements in 'array'
+ * @param 'printData' returns a string representing its 'data' parameter
+ * @param 'destroyData' destroys the 'data' parameter passed to it
+ * @param 'compareData' compares two sets of arbitrary data for ordering
+ * @return A newly allocated PriorityQueue structure pointer containing every element of 'array'; NULL on failure
+ **/
+PriorityQueue * heapifyPriorityQueue(void ** array, size_t length, char * (*printData)(void * data), void (*destroyData)(void * data), int (*compareData)(const void * a, const void * b));
+
+/**
+ * Inserts an arbitrary piece of data into the PriorityQueue in O(log n)
+ * @pre A valid PriorityQueue structure must exist for the data to be inserted into
+ * @param 'pQueue' is a pointer to the PriorityQueue that the data will be inserted into
+ * @param 'data' is a pointer to the data to be inserted
+ * @param 'handle' receives the handle issued for the data; may be NULL if the handle is not needed
+ * @return EXIT_SUCCESS is returned if the insertion is successful; EXIT_FAILURE on failure
+ **/
+int pushPriorityQueue(PriorityQueue * pQueue, void * data, PQHandle * handle);
+
+/**
+ * Retrieves the data at the front of the PriorityQueue without removing it
+ * @pre A valid PriorityQueue structure from which the data will be retreived from must exist
+ * @param 'pQueue' is a pointer to the PriorityQueue that will be accessed
+ * @return A void pointer to the lowest piece of data; NULL on failure
+ **/
+void * peekPriorityQueue(PriorityQueue * pQueue);
+
+/**
+ * Removes the data at the front of the PriorityQueue in O(log n). Ownership of the
+ * data passes to the caller and 'destroyData' is not called on it
+ * @pre A valid PriorityQueue structure from which data will be removed from must exist
+ * @param 'pQueue' is a pointer to the PriorityQueue to remove the data from
+ * @return A void pointer to the lowest piece of data; NULL on failure
+ **/
+void * popPriorityQueue(PriorityQueue * pQueue);
+
+/**
+ * Restores the ordering of the queue after the element referenced by 'handle' has decreased
+ * @pre The element must compare lower than or equal to what it did before the call
+ * @param 'pQueue' is a pointer to the PriorityQueue that will be accessed
+ * @param 'handle' is the handle of the element that has decreased
+ * @param 'data' replaces the element's data, destroying the old data; NULL if the data was updated in place
+ * @return EXIT_SUCCESS is returned if the update is successful; EXIT_FAILURE on failure
+ **/
+int decreaseKey(PriorityQueue * pQueue, PQHandle handle, void * data);
+
+/**
+ * Removes the element referenced by 'handle' from the PriorityQueue in O(log n)
+ * @pre A valid PriorityQueue structure from which data will be removed from must exist
+ * @param 'pQueue' is a pointer to the PriorityQueue to remove the data from
+ * @param 'handle' is the handle of the element to be removed
+ * @return EXIT_SUCCESS is returned if the removal is successful; EXIT_FAILURE on failure
+ **/
+int removeHandle(PriorityQueue * pQueue, PQHandle handle);
+
+/**
+ * Retrieves the data referenced by 'handle'
+ * @pre A valid PriorityQueue structure from which the data will be retreived from must exist
+ * @param 'pQueue' is a pointer to the PriorityQueue that will be accessed
+ * @param 'handle' is the handle of the element to be accessed
+ * @return A void pointer to the requested data; NULL on failure
+ **/
+void * getHandleData(PriorityQueue * pQueue, PQHandle handle);
+
+/**
+ * Destroys the entire PriorityQueue data structure and all of its elements
+ * @pre A valid PriorityQueue structure must exist to be destroyed
+ * @param 'pQueue' is a pointer to the PriorityQueue that will be destroyed
+ * @return EXIT_SUCCESS is returned if the destruction is successful; EXIT_FAILURE on failure
+ **/
+int destroyPriorityQueue(PriorityQueue * pQueue);
+
+/**
+ * Converts all of the items in the PriorityQueue to a human readable string in heap order
+ * @pre A valid PriorityQueue structure to be printed from must exist
+ * @param 'pQueue' is a pointer to the PriorityQueue that will be accessed
+ * @return A newly allocated string regardless of queue length; NULL on failure
+ **/
+char * printPriorityQueue(PriorityQueue * pQueue);
+
+#endif
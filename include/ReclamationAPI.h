@@ -0,0 +1,43 @@
+/**
+ * @file ReclamationAPI.h
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Function definitions for destroying data structures on a background thread
+ **/
+
+#ifndef RECLAMATION_API
+#define RECLAMATION_API
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <threads.h>
+
+/**
+ * Structure for a ReclamationJob waiting on the reclamation thread
+ * Member 'destroy' is a function pointer to the function that destroys the structure
+ * Member 'structure' is a pointer to the detached structure to be destroyed
+ * Member 'next' is a pointer to the next ReclamationJob in the queue
+ **/
+typedef struct ReclamationJob {
+	int (*destroy)(void * structure);
+	void * structure;
+	struct ReclamationJob * next;
+} ReclamationJob;
+
+/**
+ * Hands a structure to the shared reclamation thread, which is started on first use, to be destroyed later.
+ * If the thread cannot be started or the job cannot be queued, the structure is destroyed before returning
+ * @pre The caller must not use 'structure' after this call
+ * @param 'destroy' destroys the 'structure' parameter passed to it
+ * @param 'structure' is a pointer to the structure to be destroyed
+ * @return EXIT_SUCCESS is returned if the structure was queued or destroyed; EXIT_FAILURE on failure
+ **/
+int deferReclamation(int (*destroy)(void * structure), void * structure);
+
+/**
+ * Blocks until every structure handed to 'deferReclamation' so far has been destroyed
+ * @return EXIT_SUCCESS is returned once the queue is empty; EXIT_FAILURE on failure
+ **/
+int waitReclamation(void);
+
+#endif
@@ -0,0 +1,95 @@
+/**
+ * @file ThreadPoolAPI.h
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Function definitions for a work-stealing thread pool
+ **/
+
+#ifndef THREAD_POOL_API
+#define THREAD_POOL_API
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <threads.h>
+#include <assert.h>
+
+#include "WorkDequeAPI.h"
+
+/**
+ * Structure for a ThreadPoolTask waiting to be run
+ * Member 'function' is a function pointer to the work to be done
+ * Member 'arg' is the argument passed to 'function'
+ * Member 'next' is a pointer to the next ThreadPoolTask in the shared queue
+ **/
+typedef struct ThreadPoolTask {
+	void (*function)(void * arg);
+	void * arg;
+	struct ThreadPoolTask * next;
+} ThreadPoolTask;
+
+/**
+ * Structure for a ThreadPool. Every worker owns a WorkDeque; tasks submitted by a
+ * worker go onto its own deque and idle workers steal from the others. Tasks
+ * submitted from outside the pool go through a shared queue
+ * Member 'threadCount' is the number of worker threads
+ * Member 'threads' is an array of the worker threads
+ * Member 'deques' is an array of every worker's WorkDeque
+ * Member 'head' is a pointer to the first task in the shared queue
+ * Member 'tail' is a pointer to the last task in the shared queue
+ * Member 'lock' protects the shared queue and the condition variables
+ * Member 'wake' is signalled when a sleeping worker may have work to do
+ * Member 'idle' is signalled when every submitted task has completed
+ * Member 'pending' is the number of tasks submitted but not yet completed
+ * Member 'sleeping' is the number of workers waiting on 'wake'
+ * Member 'shutdown' is set when the workers should exit
+ **/
+typedef struct ThreadPool {
+	size_t threadCount;
+	thrd_t * threads;
+	WorkDeque ** deques;
+	ThreadPoolTask * head;
+	ThreadPoolTask * tail;
+	mtx_t lock;
+	cnd_t wake;
+	cnd_t idle;
+	atomic_size_t pending;
+	atomic_size_t sleeping;
+	atomic_bool shutdown;
+} ThreadPool;
+
+/**
+ * Function to create a new ThreadPool and start its workers
+ * @param 'threadCount' is the number of worker threads to start; must be at least one
+ * @return A newly allocated ThreadPool structure pointer; NULL on failure
+ **/
+ThreadPool * createThreadPool(size_t threadCount);
+
+/**
+ * Schedules a task to be run by one of the ThreadPool's workers
+ * @pre A valid ThreadPool structure must exist
+ * @param 'pool' is a pointer to the ThreadPool that will run the task
+ * @param 'function' is the work to be done
+ * @param 'arg' is the argument passed to 'function'
+ * @return EXIT_SUCCESS is returned if the task was scheduled; EXIT_FAILURE on failure
+ **/
+int submitThreadPool(ThreadPool * pool, void (*function)(void * arg), void * arg);
+
+/**
+ * Blocks until every task submitted to the ThreadPool, including tasks submitted by other tasks, has completed
+ * @pre Must not be called from within one of the ThreadPool's tasks
+ * @param 'pool' is a pointer to the ThreadPool that will be waited on
+ * @return EXIT_SUCCESS is returned once the pool is idle; EXIT_FAILURE on failure
+ **/
+int waitThreadPool(ThreadPool * pool);
+
+/**
+ * Waits for every outstanding task, then stops the workers and destroys the ThreadPool
+ * @pre Must not be called from within one of the ThreadPool's tasks
+ * @param 'pool' is a pointer to the ThreadPool that will be destroyed
+ * @return EXIT_SUCCESS is returned if the destruction is successful; EXIT_FAILURE on failure
+ **/
+int destroyThreadPool(ThreadPool * pool);
+
+#endif
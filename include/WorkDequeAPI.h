@@ -0,0 +1,95 @@
+/**
+ * @file WorkDequeAPI.h
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Function definitions for a lock-free Chase-Lev work-stealing deque
+ **/
+
+#ifndef WORK_DEQUE_API
+#define WORK_DEQUE_API
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <assert.h>
+
+/**
+ * Size in bytes assumed for a cache line, used to keep the two ends of a deque apart
+ **/
+#define WORK_DEQUE_CACHE_LINE 64
+
+/**
+ * Structure for the circular array backing a WorkDeque
+ * Member 'capacity' is the number of slots in the array; always a power of two
+ * Member 'prev' is a pointer to the smaller array this one replaced, kept until the deque is destroyed
+ * Member 'slots' is the array of pointers to the stored data
+ **/
+typedef struct WorkDequeBuffer {
+	size_t capacity;
+	struct WorkDequeBuffer * prev;
+	_Atomic(void *) slots[];
+} WorkDequeBuffer;
+
+/**
+ * Structure for a WorkDeque. Only one thread, the owner, may push and pop;
+ * any number of other threads may steal concurrently
+ * Member 'top' is the index of the oldest element, advanced by thieves
+ * Member 'bottom' is one past the index of the newest element, moved by the owner
+ * Member 'buffer' is a pointer to the current circular array
+ **/
+typedef struct WorkDeque {
+	_Alignas(WORK_DEQUE_CACHE_LINE) atomic_llong top;
+	_Alignas(WORK_DEQUE_CACHE_LINE) atomic_llong bottom;
+	_Atomic(WorkDequeBuffer *) buffer;
+} WorkDeque;
+
+/**
+ * Function to create a new WorkDeque data structure
+ * @param 'capacity' is the number of elements to allocate room for up front; rounded up to a power of two
+ * @return A newly allocated WorkDeque structure pointer; NULL on failure
+ **/
+WorkDeque * createWorkDeque(size_t capacity);
+
+/**
+ * Inserts a piece of data at the owner's end of the WorkDeque, growing it if needed
+ * @pre Must only be called by the owner thread; 'data' must not be NULL
+ * @param 'deque' is a pointer to the WorkDeque that the data will be inserted into
+ * @param 'data' is a pointer to the data to be inserted
+ * @return EXIT_SUCCESS is returned if the insertion is successful; EXIT_FAILURE on failure
+ **/
+int pushWorkDeque(WorkDeque * deque, void * data);
+
+/**
+ * Removes the newest piece of data from the owner's end of the WorkDeque
+ * @pre Must only be called by the owner thread
+ * @param 'deque' is a pointer to the WorkDeque to remove the data from
+ * @return A void pointer to the removed data; NULL if the deque is empty
+ **/
+void * popWorkDeque(WorkDeque * deque);
+
+/**
+ * Removes the oldest piece of data from the thieves' end of the WorkDeque
+ * @pre May be called by any thread
+ * @param 'deque' is a pointer to the WorkDeque to remove the data from
+ * @return A void pointer to the removed data; NULL if the deque is empty or another thread won the race for it
+ **/
+void * stealWorkDeque(WorkDeque * deque);
+
+/**
+ * Retrieves an estimate of the number of elements in the WorkDeque
+ * @pre A valid WorkDeque structure must exist
+ * @param 'deque' is a pointer to the WorkDeque that will be accessed
+ * @return The number of elements at the time of the call; 0 on failure
+ **/
+size_t getWorkDequeLength(WorkDeque * deque);
+
+/**
+ * Destroys the WorkDeque data structure. Any data still in the deque is not destroyed
+ * @pre No other thread may be accessing the WorkDeque
+ * @param 'deque' is a pointer to the WorkDeque that will be destroyed
+ * @return EXIT_SUCCESS is returned if the destruction is successful; EXIT_FAILURE on failure
+ **/
+int destroyWorkDeque(WorkDeque * deque);
+
+#endif
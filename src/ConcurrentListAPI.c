@@ -0,0 +1,373 @@
+/**
+ * @file ConcurrentListAPI.c
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Function implementations for a lock-free sorted linked list used as an ordered set
+ *
+ * Follows Michael's "High Performance Dynamic Lock-Free Hash Tables and
+ * List-Based Sets": removal first marks a node's next pointer and then
+ * unlinks it, and unlinked nodes are only freed once no hazard pointer
+ * refers to them
+ **/
+
+#include "ConcurrentListAPI.h"
+
+#define REMOVED_MARK ((uintptr_t)1)
+
+#define HAZARD_CUR 0
+#define HAZARD_NEXT 1
+#define HAZARD_PREV 2
+
+static ConcurrentListNode * unmarked(uintptr_t pointer) {
+    return (ConcurrentListNode *)(pointer & ~REMOVED_MARK);
+}
+
+static int comparePointers(const void * a, const void * b) {
+    uintptr_t x = *(const uintptr_t *)a;
+    uintptr_t y = *(const uintptr_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+static HazardRecord * acquireRecord(ConcurrentList * list) {
+    for (HazardRecord * record = atomic_load(&list->records); record; record = record->next) {
+        bool expected = false;
+        if (!atomic_load(&record->active) && atomic_compare_exchange_strong(&record->active, &expected, true)) {
+            return record;
+        }
+    }
+
+    HazardRecord * record = malloc(sizeof(HazardRecord));
+    if (!record) {
+        return NULL;
+    }
+
+    for (int i = 0; i < CONCURRENT_LIST_HAZARDS; ++i) {
+        atomic_init(&record->hazards[i], NULL);
+    }
+    atomic_init(&record->active, true);
+    record->retired = NULL;
+    record->retiredCount = 0;
+
+    record->next = atomic_load(&list->records);
+    while (!atomic_compare_exchange_weak(&list->records, &record->next, record));
+    atomic_fetch_add(&list->recordCount, 1);
+
+    return record;
+}
+
+static void releaseRecord(HazardRecord * record) {
+    for (int i = 0; i < CONCURRENT_LIST_HAZARDS; ++i) {
+        atomic_store(&record->hazards[i], NULL);
+    }
+    atomic_store(&record->active, false);
+}
+
+/*Frees every node retired by 'record' that no thread currently holds a hazard pointer to*/
+static void scanRetired(ConcurrentList * list, HazardRecord * record) {
+    size_t capacity = (atomic_load(&list->recordCount) + 1) * CONCURRENT_LIST_HAZARDS;
+    uintptr_t * hazards = malloc(sizeof(uintptr_t) * capacity);
+    if (!hazards) {
+        return;
+    }
+
+    /*Every record must be read, as new records are pushed at the head while the oldest may still protect these nodes*/
+    size_t count = 0;
+    for (HazardRecord * other = atomic_load(&list->records); other; other = other->next) {
+        for (int i = 0; i < CONCURRENT_LIST_HAZARDS; ++i) {
+            ConcurrentListNode * node = atomic_load(&other->hazards[i]);
+            if (!node) {
+                continue;
+            }
+
+            if (count == capacity) {
+                uintptr_t * grown = realloc(hazards, sizeof(uintptr_t) * capacity * 2);
+                if (!grown) {
+                    /*Without a complete set of hazards nothing can safely be freed; try again on the next scan*/
+                    free(hazards);
+                    return;
+                }
+                hazards = grown;
+                capacity *= 2;
+            }
+            hazards[count++] = (uintptr_t)node;
+        }
+    }
+    qsort(hazards, count, sizeof(uintptr_t), comparePointers);
+
+    ConcurrentListNode ** link = &record->retired;
+    while (*link) {
+        ConcurrentListNode * node = *link;
+        uintptr_t key = (uintptr_t)node;
+
+        if (bsearch(&key, hazards, count, sizeof(uintptr_t), comparePointers)) {
+            link = &node->retiredNext;
+            continue;
+        }
+
+        *link = node->retiredNext;
+        list->destroyData(node->data);
+        free(node);
+        record->retiredCount--;
+    }
+
+    free(hazards);
+}
+
+static void retireNode(ConcurrentList * list, HazardRecord * record, ConcurrentListNode * node) {
+    node->retiredNext = record->retired;
+    record->retired = node;
+    record->retiredCount++;
+
+    if (record->retiredCount >= 2 * CONCURRENT_LIST_HAZARDS * atomic_load(&list->recordCount) + 16) {
+        scanRetired(list, record);
+    }
+}
+
+/*
+ * Finds the first node that does not compare lower than 'data', unlinking any
+ * removed nodes on the way. On return 'cur' and the node owning 'prev' are
+ * protected by hazard pointers
+ */
+static bool findNode(ConcurrentList * list, HazardRecord * record, void * data, _Atomic(uintptr_t) ** prevOut, ConcurrentListNode ** curOut, ConcurrentListNode ** nextOut) {
+tryAgain:;
+    _Atomic(uintptr_t) * prev = &list->head;
+    ConcurrentListNode * cur = unmarked(atomic_load(prev));
+
+    while (true) {
+        if (!cur) {
+            *prevOut = prev;
+            *curOut = NULL;
+            *nextOut = NULL;
+            return false;
+        }
+
+        atomic_store(&record->hazards[HAZARD_CUR], cur);
+        if (atomic_load(prev) != (uintptr_t)cur) {
+            goto tryAgain;
+        }
+
+        uintptr_t next = atomic_load(&cur->next);
+        atomic_store(&record->hazards[HAZARD_NEXT], unmarked(next));
+        if (atomic_load(&cur->next) != next) {
+            goto tryAgain;
+        }
+
+        if (next & REMOVED_MARK) {
+            uintptr_t expected = (uintptr_t)cur;
+            if (!atomic_compare_exchange_strong(prev, &expected, next & ~REMOVED_MARK)) {
+                goto tryAgain;
+            }
+            retireNode(list, record, cur);
+        } else {
+            int comparison = list->compareData(cur->data, data);
+            if (atomic_load(prev) != (uintptr_t)cur) {
+                goto tryAgain;
+            }
+
+            if (comparison >= 0) {
+                *prevOut = prev;
+                *curOut = cur;
+                *nextOut = unmarked(next);
+                return comparison == 0;
+            }
+
+            prev = &cur->next;
+            atomic_store(&record->hazards[HAZARD_PREV], cur);
+        }
+
+        cur = unmarked(next);
+    }
+}
+
+ConcurrentList * createConcurrentList(char * (*printData)(void * data), void (*destroyData)(void * data), int (*compareData)(const void * a, const void * b)) {
+    ConcurrentList * list = malloc(sizeof(ConcurrentList));
+    if (!list) {
+        return NULL;
+    }
+
+    assert(printData);
+    assert(destroyData);
+    assert(compareData);
+
+    atomic_init(&list->head, (uintptr_t)NULL);
+    atomic_init(&list->length, 0);
+    atomic_init(&list->records, NULL);
+    atomic_init(&list->recordCount, 0);
+    list->printData = printData;
+    list->destroyData = destroyData;
+    list->compareData = compareData;
+
+    return list;
+}
+
+int insertConcurrentList(ConcurrentList * list, void * data) {
+    if (!list || !data) {
+        return EXIT_FAILURE;
+    }
+
+    ConcurrentListNode * node = malloc(sizeof(ConcurrentListNode));
+    if (!node) {
+        return EXIT_FAILURE;
+    }
+    node->data = data;
+    node->retiredNext = NULL;
+
+    HazardRecord * record = acquireRecord(list);
+    if (!record) {
+        free(node);
+        return EXIT_FAILURE;
+    }
+
+    _Atomic(uintptr_t) * prev;
+    ConcurrentListNode * cur, * next;
+    int result = EXIT_FAILURE;
+
+    while (true) {
+        if (findNode(list, record, data, &prev, &cur, &next)) {
+            free(node);
+            break;
+        }
+
+        atomic_init(&node->next, (uintptr_t)cur);
+
+        uintptr_t expected = (uintptr_t)cur;
+        if (atomic_compare_exchange_strong(prev, &expected, (uintptr_t)node)) {
+            atomic_fetch_add(&list->length, 1);
+            result = EXIT_SUCCESS;
+            break;
+        }
+    }
+
+    releaseRecord(record);
+
+    return result;
+}
+
+int removeFromConcurrentList(ConcurrentList * list, void * data) {
+    if (!list || !data) {
+        return EXIT_FAILURE;
+    }
+
+    HazardRecord * record = acquireRecord(list);
+    if (!record) {
+        return EXIT_FAILURE;
+    }
+
+    _Atomic(uintptr_t) * prev;
+    ConcurrentListNode * cur, * next;
+    int result = EXIT_FAILURE;
+
+    while (findNode(list, record, data, &prev, &cur, &next)) {
+        /*Marking the node is the point at which it is removed; whoever unlinks it afterwards retires it*/
+        uintptr_t expected = (uintptr_t)next;
+        if (!atomic_compare_exchange_strong(&cur->next, &expected, (uintptr_t)next | REMOVED_MARK)) {
+            continue;
+        }
+        atomic_fetch_sub(&list->length, 1);
+
+        expected = (uintptr_t)cur;
+        if (atomic_compare_exchange_strong(prev, &expected, (uintptr_t)next)) {
+            retireNode(list, record, cur);
+        } else {
+            findNode(list, record, data, &prev, &cur, &next);
+        }
+
+        result = EXIT_SUCCESS;
+        break;
+    }
+
+    releaseRecord(record);
+
+    return result;
+}
+
+bool concurrentListContains(ConcurrentList * list, void * data) {
+    if (!list || !data) {
+        return false;
+    }
+
+    HazardRecord * record = acquireRecord(list);
+    if (!record) {
+        return false;
+    }
+
+    _Atomic(uintptr_t) * prev;
+    ConcurrentListNode * cur, * next;
+    bool found = findNode(list, record, data, &prev, &cur, &next);
+
+    releaseRecord(record);
+
+    return found;
+}
+
+int destroyConcurrentList(ConcurrentList * list) {
+    if (!list) {
+        return EXIT_FAILURE;
+    }
+
+    ConcurrentListNode * node = unmarked(atomic_load(&list->head));
+    while (node) {
+        ConcurrentListNode * next = unmarked(atomic_load(&node->next));
+        list->destroyData(node->data);
+        free(node);
+        node = next;
+    }
+
+    HazardRecord * record = atomic_load(&list->records);
+    while (record) {
+        HazardRecord * nextRecord = record->next;
+
+        node = record->retired;
+        while (node) {
+            ConcurrentListNode * next = node->retiredNext;
+            list->destroyData(node->data);
+            free(node);
+            node = next;
+        }
+
+        free(record);
+        record = nextRecord;
+    }
+
+    free(list);
+    list = NULL;
+
+    return EXIT_SUCCESS;
+}
+
+char * printConcurrentList(ConcurrentList * list) {
+    if (!list) {
+        return NULL;
+    }
+
+    char * str = malloc(sizeof(char));
+    if (!str) {
+        return NULL;
+    }
+    strcpy(str, "");
+    char * tempPtr, * tempStr;
+
+    ConcurrentListNode * node = unmarked(atomic_load(&list->head));
+    while (node) {
+        uintptr_t next = atomic_load(&node->next);
+
+        if (!(next & REMOVED_MARK)) {
+            tempStr = list->printData(node->data);
+
+            tempPtr = realloc(str, sizeof(char) * (strlen(str) + strlen(tempStr) + 2));
+            if (!tempPtr) {
+                free(str);
+                free(tempStr);
+                return NULL;
+            }
+            str = tempPtr;
+
+            strcat(str, tempStr);
+            free(tempStr);
+        }
+
+        node = unmarked(next);
+    }
+
+    return str;
+}
@@ -5,6 +5,239 @@
  **/
 
 #include "HashTableAPI.h"
+#include "ThreadPoolAPI.h"
+#include "ReclamationAPI.h"
+#include "PageAllocAPI.h"
+
+/*Spreads the bits of a value across a 64 bit hash; the finalizer from MurmurHash3*/
+static uint64_t mixBits(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+static uint64_t mixKey(int key) {
+    return mixBits((uint32_t)key);
+}
+
+static int countBits(uint64_t word) {
+    int count = 0;
+
+    while (word) {
+        word &= word - 1;
+        count++;
+    }
+
+    return count;
+}
+
+/*
+ * Picks the key's block from a second mix of the hash; the words take one bit each from its low 48 bits.
+ * Sharing bits between the two would make every key in a block set the same bits in some words
+ */
+static uint64_t * filterBlock(HTableFilter * filter, uint64_t hash) {
+    return &filter->blocks[(mixBits(hash ^ 0x9e3779b97f4a7c15ULL) % filter->blockCount) * HTABLE_FILTER_BLOCK_WORDS];
+}
+
+static void addFilterKey(HTableFilter * filter, int key) {
+    uint64_t hash = mixKey(key);
+    uint64_t * block = filterBlock(filter, hash);
+
+    for (int i = 0; i < HTABLE_FILTER_BLOCK_WORDS; ++i) {
+        block[i] |= (uint64_t)1 << ((hash >> (i * 6)) & 63);
+    }
+}
+
+static bool filterMayContain(HTableFilter * filter, int key) {
+    uint64_t hash = mixKey(key);
+    uint64_t * block = filterBlock(filter, hash);
+
+    for (int i = 0; i < HTABLE_FILTER_BLOCK_WORDS; ++i) {
+        if (!(block[i] & ((uint64_t)1 << ((hash >> (i * 6)) & 63)))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*Resizes the filter for the table's current contents and re-adds every key*/
+static int rebuildTableFilter(HTable * hTable) {
+    HTableFilter * filter = hTable->filter;
+    size_t capacity = hTable->length > hTable->size ? hTable->length : hTable->size;
+    size_t blockBits = HTABLE_FILTER_BLOCK_WORDS * 64;
+    size_t blockCount = (capacity * filter->bitsPerKey + blockBits - 1) / blockBits;
+    if (blockCount == 0) {
+        blockCount = 1;
+    }
+
+    size_t bytes = blockCount * HTABLE_FILTER_BLOCK_WORDS * sizeof(uint64_t);
+
+    if (blockCount != filter->blockCount) {
+        uint64_t * blocks = aligned_alloc(HTABLE_FILTER_BLOCK_WORDS * sizeof(uint64_t), bytes);
+        if (!blocks) {
+            /*Keep the old filter; it only answers "maybe" more often than it should*/
+            return EXIT_FAILURE;
+        }
+
+        free(filter->blocks);
+        filter->blocks = blocks;
+        filter->blockCount = blockCount;
+    }
+
+    memset(filter->blocks, 0, bytes);
+    filter->capacity = capacity;
+    filter->staleCount = 0;
+
+    for (size_t i = 0; i < hTable->size; ++i) {
+        for (HTableNode * temp = hTable->table[i]; temp; temp = temp->next) {
+            addFilterKey(filter, temp->key);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/*Large blocks owned by the table come straight from the operating system when huge pages are asked for*/
+static void * allocateTableMemory(int flags, size_t bytes) {
+    if (flags & HTABLE_HUGE_PAGES) {
+        return allocatePages(bytes, true);
+    }
+
+    return malloc(bytes);
+}
+
+static void freeTableMemory(int flags, void * memory, size_t bytes) {
+    if (flags & HTABLE_HUGE_PAGES) {
+        freePages(memory, bytes, true);
+    } else {
+        free(memory);
+    }
+}
+
+/*Nodes carved from the table's slab are released with the slab, not one by one*/
+static bool isSlabNode(HTable * hTable, HTableNode * node) {
+    uintptr_t address = (uintptr_t)node;
+    uintptr_t start = (uintptr_t)hTable->slab;
+
+    return hTable->slab && address >= start && address < start + hTable->slabLength * sizeof(HTableNode);
+}
+
+static int destroyTableJob(void * structure) {
+    return destroyTable(structure);
+}
+
+/*
+ * Shared state for building a table across threads. The input is split into
+ * 'slices' for hashing and scattering, and the buckets into 'partitions' of
+ * adjacent buckets that are each linked by one task
+ */
+typedef struct TableBuild {
+    HTable * hTable;
+    const int * keys;
+    void ** values;
+    size_t length;
+    size_t slices;
+    size_t partitions;
+    int * buckets;
+    size_t * order;
+    size_t * counts;
+    size_t * partitionStarts;
+    size_t * added;
+} TableBuild;
+
+typedef struct TableBuildTask {
+    TableBuild * build;
+    size_t index;
+} TableBuildTask;
+
+static size_t bucketPartition(TableBuild * build, int bucket) {
+    return (size_t)bucket * build->partitions / build->hTable->size;
+}
+
+/*Hashes one slice of the input and counts how many of its keys fall in each partition*/
+static void hashSlice(void * arg) {
+    TableBuildTask * task = arg;
+    TableBuild * build = task->build;
+    size_t start = build->length * task->index / build->slices;
+    size_t end = build->length * (task->index + 1) / build->slices;
+    size_t * counts = &build->counts[task->index * build->partitions];
+
+    for (size_t i = start; i < end; ++i) {
+        int bucket = build->hTable->hashData(build->hTable->size, build->keys[i]);
+        build->buckets[i] = bucket;
+        counts[bucketPartition(build, bucket)]++;
+    }
+}
+
+/*Writes the input indices of one slice into each partition's range of 'order', keeping input order*/
+static void scatterSlice(void * arg) {
+    TableBuildTask * task = arg;
+    TableBuild * build = task->build;
+    size_t start = build->length * task->index / build->slices;
+    size_t end = build->length * (task->index + 1) / build->slices;
+    size_t * offsets = &build->counts[task->index * build->partitions];
+
+    for (size_t i = start; i < end; ++i) {
+        build->order[offsets[bucketPartition(build, build->buckets[i])]++] = i;
+    }
+}
+
+/*Links every node of one partition; no other task touches these buckets or this part of the slab*/
+static void linkPartition(void * arg) {
+    TableBuildTask * task = arg;
+    TableBuild * build = task->build;
+    HTable * hTable = build->hTable;
+    size_t added = 0;
+
+    for (size_t position = build->partitionStarts[task->index]; position < build->partitionStarts[task->index + 1]; ++position) {
+        size_t i = build->order[position];
+        int bucket = build->buckets[i];
+        HTableNode * temp = hTable->table[bucket];
+
+        while (temp && temp->key != build->keys[i]) {
+            temp = temp->next;
+        }
+
+        if (temp) {
+            if (temp->data != build->values[i]) {
+                hTable->destroyData(temp->data);
+                temp->data = build->values[i];
+            }
+            continue;
+        }
+
+        HTableNode * node = &hTable->slab[position];
+        node->key = build->keys[i];
+        node->data = build->values[i];
+        node->next = hTable->table[bucket];
+        hTable->table[bucket] = node;
+        added++;
+    }
+
+    build->added[task->index] = added;
+}
+
+/*
+ * Runs one step of the build for every index, on the pool if there is one. A task the pool
+ * cannot take runs on the calling thread instead, so a step never stops part way; linking
+ * destroys the data of repeated keys and must not be left half done
+ */
+static void runBuildStep(ThreadPool * pool, TableBuildTask * tasks, size_t count, void (*step)(void * arg)) {
+    for (size_t i = 0; i < count; ++i) {
+        if (!pool || submitThreadPool(pool, step, &tasks[i]) != EXIT_SUCCESS) {
+            step(&tasks[i]);
+        }
+    }
+
+    if (pool) {
+        waitThreadPool(pool);
+    }
+}
 
 HTableNode * createHTableNode(int key, void * data) {
     HTableNode * node = malloc(sizeof(HTableNode));
@@ -19,27 +252,57 @@ HTableNode * createHTableNode(int key, void * data) {
     return node;
 }
 
+/*Allocates a node with room for the value directly behind it, so both share one allocation and usually one cache line*/
+static HTableNode * createInlineNode(HTable * hTable, int key, const void * data) {
+    HTableNode * node = malloc(sizeof(HTableNode) + hTable->valueSize);
+    if (!node) {
+        return NULL;
+    }
+
+    node->next = NULL;
+    node->key = key;
+    node->data = node + 1;
+    memcpy(node->data, data, hTable->valueSize);
+
+    return node;
+}
+
 HTable * createTable(size_t size, char * (*printData)(void * data), void (*destroyData)(void * data), int (*hashData)(size_t tableSize, int key)) {
+    return createTableWithFlags(size, 0, printData, destroyData, hashData);
+}
+
+/*Shared by the constructors; 'destroyData' is only required when values are held by pointer*/
+static HTable * initTable(size_t size, int flags, size_t valueSize, char * (*printData)(void * data), void (*destroyData)(void * data), int (*hashData)(size_t tableSize, int key)) {
     HTable * hTable = malloc(sizeof(HTable));
     if (!hTable) {
     	return NULL;
     }
 
-    hTable->table = malloc(sizeof(HTableNode*) * size);
+    hTable->table = allocateTableMemory(flags, sizeof(HTableNode*) * size);
     if (!hTable->table) {
     	free(hTable);
     	return NULL;
     }
 
-    for (int i = 0; i < hTable->size; ++i) {
-    	hTable->table[i] = NULL;
+    /*Mapped pages are already zero, and leaving them untouched lets a parallel build place them*/
+    if (!(flags & HTABLE_HUGE_PAGES)) {
+        for (size_t i = 0; i < size; ++i) {
+        	hTable->table[i] = NULL;
+        }
     }
 
     assert(printData);
-    assert(destroyData);
+    assert(destroyData || valueSize > 0);
     assert(hashData);
 
     hTable->size = size;
+    hTable->length = 0;
+    hTable->filter = NULL;
+    hTable->slab = NULL;
+    hTable->slabLength = 0;
+    hTable->slabUsed = 0;
+    hTable->flags = flags;
+    hTable->valueSize = valueSize;
     hTable->printData = printData;
     hTable->destroyData = destroyData;
     hTable->hashData = hashData;
@@ -47,29 +310,169 @@ HTable * createTable(size_t size, char * (*printData)(void * data), void (*destr
     return hTable;
 }
 
+HTable * createTableWithFlags(size_t size, int flags, char * (*printData)(void * data), void (*destroyData)(void * data), int (*hashData)(size_t tableSize, int key)) {
+    return initTable(size, flags, 0, printData, destroyData, hashData);
+}
+
+HTable * createTableInline(size_t size, size_t valueSize, int flags, char * (*printData)(void * data), int (*hashData)(size_t tableSize, int key)) {
+    if (valueSize == 0) {
+        return NULL;
+    }
+
+    return initTable(size, flags, valueSize, printData, NULL, hashData);
+}
+
+HTable * createTableFromArrays(const int * keys, void ** values, size_t length, size_t threads, char * (*printData)(void * data), void (*destroyData)(void * data), int (*hashData)(size_t tableSize, int key)) {
+    return createTableFromArraysWithFlags(keys, values, length, threads, 0, printData, destroyData, hashData);
+}
+
+HTable * createTableFromArraysWithFlags(const int * keys, void ** values, size_t length, size_t threads, int flags, char * (*printData)(void * data), void (*destroyData)(void * data), int (*hashData)(size_t tableSize, int key)) {
+    if (length > 0 && (!keys || !values)) {
+        return NULL;
+    }
+
+    HTable * hTable = createTableWithFlags(length > 0 ? length : 1, flags, printData, destroyData, hashData);
+    if (!hTable || length == 0) {
+        return hTable;
+    }
+
+    if (threads == 0) {
+        threads = 1;
+    }
+    if (threads > length) {
+        threads = length;
+    }
+
+    /*A few partitions per thread lets idle workers steal from ones holding crowded buckets*/
+    TableBuild build;
+    build.hTable = hTable;
+    build.keys = keys;
+    build.values = values;
+    build.length = length;
+    build.slices = threads;
+    build.partitions = threads > 1 ? threads * 4 : 1;
+    if (build.partitions > hTable->size) {
+        build.partitions = hTable->size;
+    }
+
+    size_t taskCount = build.slices > build.partitions ? build.slices : build.partitions;
+
+    hTable->slab = allocateTableMemory(flags, sizeof(HTableNode) * length);
+    build.buckets = malloc(sizeof(int) * length);
+    build.order = malloc(sizeof(size_t) * length);
+    build.counts = calloc(build.slices * build.partitions, sizeof(size_t));
+    build.partitionStarts = malloc(sizeof(size_t) * (build.partitions + 1));
+    build.added = calloc(build.partitions, sizeof(size_t));
+    TableBuildTask * tasks = malloc(sizeof(TableBuildTask) * taskCount);
+    ThreadPool * pool = threads > 1 ? createThreadPool(threads) : NULL;
+
+    /*Only allocation can fail, and it is checked before any step runs, so a failed build has not touched the data*/
+    if (!hTable->slab || !build.buckets || !build.order || !build.counts || !build.partitionStarts || !build.added || !tasks) {
+        if (pool) {
+            destroyThreadPool(pool);
+        }
+        free(tasks);
+        free(build.added);
+        free(build.partitionStarts);
+        free(build.counts);
+        free(build.order);
+        free(build.buckets);
+
+        /*Nothing has been linked or destroyed, so the caller still owns every value*/
+        freeTableMemory(flags, hTable->slab, sizeof(HTableNode) * length);
+        hTable->slab = NULL;
+        destroyTable(hTable);
+        return NULL;
+    }
+
+    hTable->slabLength = length;
+
+    for (size_t i = 0; i < taskCount; ++i) {
+        tasks[i].build = &build;
+        tasks[i].index = i;
+    }
+
+    runBuildStep(pool, tasks, build.slices, hashSlice);
+
+    /*Turn the per slice counts into starting offsets, partition by partition and slice by slice*/
+    size_t offset = 0;
+    for (size_t p = 0; p < build.partitions; ++p) {
+        build.partitionStarts[p] = offset;
+        for (size_t t = 0; t < build.slices; ++t) {
+            size_t count = build.counts[t * build.partitions + p];
+            build.counts[t * build.partitions + p] = offset;
+            offset += count;
+        }
+    }
+    build.partitionStarts[build.partitions] = offset;
+
+    runBuildStep(pool, tasks, build.slices, scatterSlice);
+    runBuildStep(pool, tasks, build.partitions, linkPartition);
+
+    for (size_t p = 0; p < build.partitions; ++p) {
+        hTable->length += build.added[p];
+    }
+    hTable->slabUsed = hTable->length;
+
+    if (pool) {
+        destroyThreadPool(pool);
+    }
+    free(tasks);
+    free(build.added);
+    free(build.partitionStarts);
+    free(build.counts);
+    free(build.order);
+    free(build.buckets);
+
+    return hTable;
+}
+
 int insertData(HTable * hTable, int key, void * data) {
-    if (!hTable) {
+    if (!hTable || (hTable->valueSize > 0 && !data)) {
         return EXIT_FAILURE;
     }
 
     int index = hTable->hashData(hTable->size, key);
 
-    if (hTable->table[index]) {
-        HTableNode * temp = hTable->table[index];
-        while (temp) {
-            if (hTable->table[index]->key == key){
+    HTableNode * temp = hTable->table[index];
+    HTableNode * prev = NULL;
+
+    while (temp) {
+        if (temp->key == key) {
+            if (hTable->valueSize > 0) {
+                memcpy(temp->data, data, hTable->valueSize);
+            } else if (temp->data != data) {
                 hTable->destroyData(temp->data);
                 temp->data = data;
-
-                return EXIT_SUCCESS;
             }
-            temp = temp->next;
+
+            return EXIT_SUCCESS;
+        }
+        prev = temp;
+        temp = temp->next;
+    }
+
+    HTableNode * node = hTable->valueSize > 0 ? createInlineNode(hTable, key, data) : createHTableNode(key, data);
+    if (!node) {
+        return EXIT_FAILURE;
+    }
+
+    if (prev) {
+        prev->next = node;
+    } else {
+        hTable->table[index] = node;
+    }
+    hTable->length++;
+
+    if (hTable->filter) {
+        addFilterKey(hTable->filter, key);
+
+        /*Past twice the keys it was sized for, the false positive rate has climbed too far to be worth keeping*/
+        if (hTable->length > hTable->filter->capacity * 2) {
+            rebuildTableFilter(hTable);
         }
-        temp->next = createHTableNode(key, data);
-        return EXIT_SUCCESS;
     }
 
-    hTable->table[index] = createHTableNode(key, data);
     return EXIT_SUCCESS;
 }
 
@@ -78,55 +481,89 @@ int destroyTable(HTable * hTable) {
         return EXIT_FAILURE;
     }
 
-    for (int i = 0; i < hTable->size; ++i) {
+    /*When every node lives in the slab there is nothing to free per node, only data to destroy*/
+    bool slabOnly = hTable->slabUsed == hTable->length;
+
+    for (size_t i = 0; i < hTable->size && hTable->length > 0; ++i) {
         HTableNode * temp = hTable->table[i];
 
         while (temp) {
-            hTable->destroyData(temp->data);
+            if (hTable->valueSize == 0) {
+                hTable->destroyData(temp->data);
+            }
             HTableNode * prev = temp;
             temp = temp->next;
-            free(prev);
+            if (!slabOnly && !isSlabNode(hTable, prev)) {
+                free(prev);
+            }
             prev = NULL;
         }
     }
 
-    free(hTable->table);
+    freeTableMemory(hTable->flags, hTable->table, sizeof(HTableNode *) * hTable->size);
     hTable->table = NULL;
 
+    freeTableMemory(hTable->flags, hTable->slab, sizeof(HTableNode) * hTable->slabLength);
+    hTable->slab = NULL;
+
+    destroyTableFilter(hTable);
+
     free(hTable);
     hTable = NULL;
 
     return EXIT_SUCCESS;
 }
 
+int destroyTableAsync(HTable * hTable) {
+    if (!hTable) {
+        return EXIT_FAILURE;
+    }
+
+    return deferReclamation(destroyTableJob, hTable);
+}
+
 int removeData(HTable * hTable, int key) {
     if (!hTable) {
         return EXIT_FAILURE;
     }
 
-    int index = hTable->hashData(hTable->size, key);
+    if (hTable->filter && !filterMayContain(hTable->filter, key)) {
+        return EXIT_FAILURE;
+    }
 
-    if (hTable->table[index]) {
-        HTableNode * temp = hTable->table[index];
+    int index = hTable->hashData(hTable->size, key);
 
-        while (temp) {
-            HTableNode * prev = temp;
+    HTableNode * temp = hTable->table[index];
+    HTableNode * prev = NULL;
 
-            if (temp->key == key) {
-                if (!prev) {
-                    hTable->table[index] = temp->next;
-                } else {
-                    prev->next = temp->next;
-                }
+    while (temp) {
+        if (temp->key == key) {
+            if (!prev) {
+                hTable->table[index] = temp->next;
+            } else {
+                prev->next = temp->next;
+            }
 
+            if (hTable->valueSize == 0) {
                 hTable->destroyData(temp->data);
+            }
+            if (isSlabNode(hTable, temp)) {
+                hTable->slabUsed--;
+            } else {
                 free(temp);
+            }
+            hTable->length--;
 
-                return EXIT_SUCCESS;
+            /*Bits cannot be cleared from the filter, so rebuild it once enough removed keys linger in it*/
+            if (hTable->filter && ++hTable->filter->staleCount > hTable->filter->capacity / 2) {
+                rebuildTableFilter(hTable);
             }
 
-            temp = temp->next;
+            return EXIT_SUCCESS;
         }
+
+        prev = temp;
+        temp = temp->next;
     }
 
     return EXIT_FAILURE;
@@ -137,6 +574,10 @@ void * lookupData(HTable * hTable, int key) {
         return NULL;
     }
 
+    if (hTable->filter && !filterMayContain(hTable->filter, key)) {
+        return NULL;
+    }
+
     int index = hTable->hashData(hTable->size, key);
 
     if (!hTable->table[index]) {
@@ -155,7 +596,11 @@ void * lookupData(HTable * hTable, int key) {
     return NULL;
 }
 
-char * printList(HTable * hTable) {
+char * printTable(HTable * hTable) {
+    if (!hTable) {
+        return NULL;
+    }
+
     char * str = malloc(sizeof(char));
     if (!str) {
         return NULL;
@@ -163,7 +608,7 @@ char * printList(HTable * hTable) {
     strcpy(str, "");
     char * tempPtr, * tempStr;
 
-    for (int i = 0; i < hTable->size; ++i) {
+    for (size_t i = 0; i < hTable->size; ++i) {
         HTableNode * temp = hTable->table[i];
 
         while (temp) {
@@ -184,4 +629,94 @@ char * printList(HTable * hTable) {
     }
 
     return str;
-}
\ No newline at end of file
+}
+
+int createTableFilter(HTable * hTable, size_t bitsPerKey) {
+    if (!hTable) {
+        return EXIT_FAILURE;
+    }
+
+    HTableFilter * filter = malloc(sizeof(HTableFilter));
+    if (!filter) {
+        return EXIT_FAILURE;
+    }
+
+    filter->blocks = NULL;
+    filter->blockCount = 0;
+    filter->bitsPerKey = bitsPerKey > 0 ? bitsPerKey : HTABLE_FILTER_BITS_PER_KEY;
+    filter->capacity = 0;
+    filter->staleCount = 0;
+
+    destroyTableFilter(hTable);
+    hTable->filter = filter;
+
+    if (rebuildTableFilter(hTable) != EXIT_SUCCESS) {
+        destroyTableFilter(hTable);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int destroyTableFilter(HTable * hTable) {
+    if (!hTable) {
+        return EXIT_FAILURE;
+    }
+
+    if (hTable->filter) {
+        free(hTable->filter->blocks);
+        free(hTable->filter);
+        hTable->filter = NULL;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+HTableStats getTableStats(HTable * hTable) {
+    HTableStats stats;
+    memset(&stats, 0, sizeof(HTableStats));
+
+    if (!hTable) {
+        return stats;
+    }
+
+    stats.length = hTable->length;
+    stats.size = hTable->size;
+
+    for (size_t i = 0; i < hTable->size; ++i) {
+        size_t chain = 0;
+        for (HTableNode * temp = hTable->table[i]; temp; temp = temp->next) {
+            chain++;
+        }
+
+        if (chain > 0) {
+            stats.usedBuckets++;
+        }
+        if (chain > stats.longestChain) {
+            stats.longestChain = chain;
+        }
+    }
+
+    stats.filterFalsePositiveRate = 1.0;
+
+    if (hTable->filter) {
+        HTableFilter * filter = hTable->filter;
+        double total = 0.0;
+
+        /*A missing key passes only if its bit is set in every word of its block*/
+        for (size_t i = 0; i < filter->blockCount; ++i) {
+            uint64_t * block = &filter->blocks[i * HTABLE_FILTER_BLOCK_WORDS];
+            double rate = 1.0;
+
+            for (int j = 0; j < HTABLE_FILTER_BLOCK_WORDS; ++j) {
+                rate *= countBits(block[j]) / 64.0;
+            }
+            total += rate;
+        }
+
+        stats.filterBytes = sizeof(HTableFilter) + filter->blockCount * HTABLE_FILTER_BLOCK_WORDS * sizeof(uint64_t);
+        stats.filterFalsePositiveRate = filter->blockCount > 0 ? total / filter->blockCount : 0.0;
+    }
+
+    return stats;
+}
@@ -0,0 +1,963 @@
+/**
+ * @file IntSetAPI.c
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Function implementations for a compressed set of integers using Roaring style containers
+ *
+ * Values are offset by 2^31 so that unsigned order matches signed order, then
+ * split into a 16 bit container key and a 16 bit value within the container
+ **/
+
+#include "IntSetAPI.h"
+
+#define BITMAP_BYTES (INT_SET_BITMAP_WORDS * sizeof(uint64_t))
+
+static uint32_t toUnsigned(int value) {
+    return (uint32_t)value ^ 0x80000000u;
+}
+
+static int toSigned(uint32_t value) {
+    return value >= 0x80000000u ? (int)(value - 0x80000000u) : (int)value - INT_MAX - 1;
+}
+
+static int countBits(uint64_t word) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    while (word) {
+        word &= word - 1;
+        count++;
+    }
+    return count;
+#endif
+}
+
+static int lowestBit(uint64_t word) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int index = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+static bool testBit(const uint64_t * bitmap, uint16_t low) {
+    return (bitmap[low >> 6] >> (low & 63)) & 1;
+}
+
+static void setBit(uint64_t * bitmap, uint16_t low) {
+    bitmap[low >> 6] |= (uint64_t)1 << (low & 63);
+}
+
+static void clearBit(uint64_t * bitmap, uint16_t low) {
+    bitmap[low >> 6] &= ~((uint64_t)1 << (low & 63));
+}
+
+static uint32_t countBitmap(const uint64_t * bitmap) {
+    uint32_t count = 0;
+
+    for (int i = 0; i < INT_SET_BITMAP_WORDS; ++i) {
+        count += countBits(bitmap[i]);
+    }
+
+    return count;
+}
+
+/*Returns the index of the first entry not below 'low'*/
+static uint32_t searchArray(const uint16_t * array, uint32_t count, uint16_t low) {
+    uint32_t start = 0, end = count;
+
+    while (start < end) {
+        uint32_t mid = (start + end) / 2;
+        if (array[mid] < low) {
+            start = mid + 1;
+        } else {
+            end = mid;
+        }
+    }
+
+    return start;
+}
+
+/*Returns the index of the last run starting at or below 'low', or 'count' if there is none*/
+static uint32_t searchRuns(const IntSetRun * runs, uint32_t count, uint16_t low) {
+    uint32_t start = 0, end = count;
+
+    while (start < end) {
+        uint32_t mid = (start + end) / 2;
+        if (runs[mid].start <= low) {
+            start = mid + 1;
+        } else {
+            end = mid;
+        }
+    }
+
+    return start > 0 ? start - 1 : count;
+}
+
+static void freeContainer(IntSetContainer * container) {
+    free(container->array);
+    container->array = NULL;
+}
+
+static int reserveArray(IntSetContainer * container, uint32_t capacity) {
+    if (capacity <= container->capacity) {
+        return EXIT_SUCCESS;
+    }
+
+    uint16_t * array = realloc(container->array, sizeof(uint16_t) * capacity);
+    if (!array) {
+        return EXIT_FAILURE;
+    }
+
+    container->array = array;
+    container->capacity = capacity;
+
+    return EXIT_SUCCESS;
+}
+
+static int arrayToBitmap(IntSetContainer * container) {
+    uint64_t * bitmap = calloc(INT_SET_BITMAP_WORDS, sizeof(uint64_t));
+    if (!bitmap) {
+        return EXIT_FAILURE;
+    }
+
+    for (uint32_t i = 0; i < container->count; ++i) {
+        setBit(bitmap, container->array[i]);
+    }
+
+    free(container->array);
+    container->bitmap = bitmap;
+    container->type = INT_SET_BITMAP;
+    container->count = 0;
+    container->capacity = 0;
+
+    return EXIT_SUCCESS;
+}
+
+static int bitmapToArray(IntSetContainer * container) {
+    uint16_t * array = malloc(sizeof(uint16_t) * (container->cardinality > 0 ? container->cardinality : 1));
+    if (!array) {
+        return EXIT_FAILURE;
+    }
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < INT_SET_BITMAP_WORDS; ++i) {
+        uint64_t word = container->bitmap[i];
+        while (word) {
+            array[count++] = (uint16_t)(i * 64 + lowestBit(word));
+            word &= word - 1;
+        }
+    }
+
+    free(container->bitmap);
+    container->array = array;
+    container->type = INT_SET_ARRAY;
+    container->count = count;
+    container->capacity = container->cardinality > 0 ? container->cardinality : 1;
+
+    return EXIT_SUCCESS;
+}
+
+/*Expands a run container into an array or bitmap, whichever suits its cardinality*/
+static int runToNatural(IntSetContainer * container) {
+    IntSetRun * runs = container->runs;
+
+    if (container->cardinality > INT_SET_ARRAY_MAX) {
+        uint64_t * bitmap = calloc(INT_SET_BITMAP_WORDS, sizeof(uint64_t));
+        if (!bitmap) {
+            return EXIT_FAILURE;
+        }
+
+        for (uint32_t i = 0; i < container->count; ++i) {
+            for (uint32_t low = runs[i].start; low <= (uint32_t)runs[i].start + runs[i].length; ++low) {
+                setBit(bitmap, (uint16_t)low);
+            }
+        }
+
+        free(runs);
+        container->bitmap = bitmap;
+        container->type = INT_SET_BITMAP;
+        container->count = 0;
+        container->capacity = 0;
+
+        return EXIT_SUCCESS;
+    }
+
+    uint16_t * array = malloc(sizeof(uint16_t) * container->cardinality);
+    if (!array) {
+        return EXIT_FAILURE;
+    }
+
+    uint32_t count = 0;
+    for (uint32_t i = 0; i < container->count; ++i) {
+        for (uint32_t low = runs[i].start; low <= (uint32_t)runs[i].start + runs[i].length; ++low) {
+            array[count++] = (uint16_t)low;
+        }
+    }
+
+    free(runs);
+    container->array = array;
+    container->type = INT_SET_ARRAY;
+    container->count = count;
+    container->capacity = container->cardinality;
+
+    return EXIT_SUCCESS;
+}
+
+static int cloneContainer(const IntSetContainer * source, IntSetContainer * clone) {
+    *clone = *source;
+
+    size_t bytes;
+    if (source->type == INT_SET_BITMAP) {
+        bytes = BITMAP_BYTES;
+    } else if (source->type == INT_SET_RUN) {
+        bytes = sizeof(IntSetRun) * source->count;
+    } else {
+        bytes = sizeof(uint16_t) * source->count;
+    }
+
+    clone->array = malloc(bytes > 0 ? bytes : 1);
+    if (!clone->array) {
+        return EXIT_FAILURE;
+    }
+    memcpy(clone->array, source->array, bytes);
+    clone->capacity = source->type == INT_SET_BITMAP ? 0 : source->count;
+
+    return EXIT_SUCCESS;
+}
+
+static bool containerContains(const IntSetContainer * container, uint16_t low) {
+    if (container->type == INT_SET_BITMAP) {
+        return testBit(container->bitmap, low);
+    }
+
+    if (container->type == INT_SET_RUN) {
+        uint32_t index = searchRuns(container->runs, container->count, low);
+        return index < container->count && low <= (uint32_t)container->runs[index].start + container->runs[index].length;
+    }
+
+    uint32_t index = searchArray(container->array, container->count, low);
+    return index < container->count && container->array[index] == low;
+}
+
+/*Returns the index of the container for 'key', or where it would be inserted*/
+static size_t searchContainers(const IntSet * set, uint16_t key) {
+    size_t start = 0, end = set->count;
+
+    while (start < end) {
+        size_t mid = (start + end) / 2;
+        if (set->containers[mid].key < key) {
+            start = mid + 1;
+        } else {
+            end = mid;
+        }
+    }
+
+    return start;
+}
+
+/*Appends a finished container to a set being built in key order; empty containers are dropped*/
+static int appendContainer(IntSet * set, IntSetContainer * container) {
+    if (container->cardinality == 0) {
+        freeContainer(container);
+        return EXIT_SUCCESS;
+    }
+
+    if (set->count == set->capacity) {
+        size_t capacity = set->capacity > 0 ? set->capacity * 2 : 4;
+        IntSetContainer * containers = realloc(set->containers, sizeof(IntSetContainer) * capacity);
+        if (!containers) {
+            freeContainer(container);
+            return EXIT_FAILURE;
+        }
+        set->containers = containers;
+        set->capacity = capacity;
+    }
+
+    set->containers[set->count++] = *container;
+    set->length += container->cardinality;
+
+    return EXIT_SUCCESS;
+}
+
+/*Gives read access to a container as an array or bitmap, expanding a run container into 'scratch'*/
+static const IntSetContainer * naturalView(const IntSetContainer * container, IntSetContainer * scratch) {
+    if (container->type != INT_SET_RUN) {
+        return container;
+    }
+
+    if (cloneContainer(container, scratch) != EXIT_SUCCESS) {
+        return NULL;
+    }
+    if (runToNatural(scratch) != EXIT_SUCCESS) {
+        freeContainer(scratch);
+        return NULL;
+    }
+
+    return scratch;
+}
+
+static int newBitmap(IntSetContainer * container, uint16_t key) {
+    container->key = key;
+    container->type = INT_SET_BITMAP;
+    container->cardinality = 0;
+    container->count = 0;
+    container->capacity = 0;
+    container->bitmap = calloc(INT_SET_BITMAP_WORDS, sizeof(uint64_t));
+
+    return container->bitmap ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static int newArray(IntSetContainer * container, uint16_t key, uint32_t capacity) {
+    container->key = key;
+    container->type = INT_SET_ARRAY;
+    container->cardinality = 0;
+    container->count = 0;
+    container->capacity = capacity > 0 ? capacity : 1;
+    container->array = malloc(sizeof(uint16_t) * container->capacity);
+
+    return container->array ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*Sparse bitmaps produced by an operation become arrays again*/
+static int shrinkBitmap(IntSetContainer * container) {
+    if (container->type == INT_SET_BITMAP && container->cardinality <= INT_SET_ARRAY_MAX) {
+        return bitmapToArray(container);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+static int unionContainers(const IntSetContainer * a, const IntSetContainer * b, IntSetContainer * out) {
+    if (a->type == INT_SET_ARRAY && b->type == INT_SET_ARRAY) {
+        if (a->count + b->count > INT_SET_ARRAY_MAX) {
+            if (newBitmap(out, a->key) != EXIT_SUCCESS) {
+                return EXIT_FAILURE;
+            }
+            for (uint32_t i = 0; i < a->count; ++i) {
+                setBit(out->bitmap, a->array[i]);
+            }
+            for (uint32_t i = 0; i < b->count; ++i) {
+                setBit(out->bitmap, b->array[i]);
+            }
+            out->cardinality = countBitmap(out->bitmap);
+            return shrinkBitmap(out);
+        }
+
+        if (newArray(out, a->key, a->count + b->count) != EXIT_SUCCESS) {
+            return EXIT_FAILURE;
+        }
+
+        uint32_t i = 0, j = 0, count = 0;
+        while (i < a->count && j < b->count) {
+            if (a->array[i] < b->array[j]) {
+                out->array[count++] = a->array[i++];
+            } else if (a->array[i] > b->array[j]) {
+                out->array[count++] = b->array[j++];
+            } else {
+                out->array[count++] = a->array[i++];
+                j++;
+            }
+        }
+        while (i < a->count) {
+            out->array[count++] = a->array[i++];
+        }
+        while (j < b->count) {
+            out->array[count++] = b->array[j++];
+        }
+
+        out->count = count;
+        out->cardinality = count;
+        return EXIT_SUCCESS;
+    }
+
+    if (a->type == INT_SET_ARRAY) {
+        const IntSetContainer * temp = a;
+        a = b;
+        b = temp;
+    }
+
+    if (newBitmap(out, a->key) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    if (b->type == INT_SET_BITMAP) {
+        for (int i = 0; i < INT_SET_BITMAP_WORDS; ++i) {
+            out->bitmap[i] = a->bitmap[i] | b->bitmap[i];
+        }
+    } else {
+        memcpy(out->bitmap, a->bitmap, BITMAP_BYTES);
+        for (uint32_t i = 0; i < b->count; ++i) {
+            setBit(out->bitmap, b->array[i]);
+        }
+    }
+
+    out->cardinality = countBitmap(out->bitmap);
+    return EXIT_SUCCESS;
+}
+
+static int intersectContainers(const IntSetContainer * a, const IntSetContainer * b, IntSetContainer * out) {
+    if (a->type == INT_SET_BITMAP && b->type == INT_SET_BITMAP) {
+        if (newBitmap(out, a->key) != EXIT_SUCCESS) {
+            return EXIT_FAILURE;
+        }
+        for (int i = 0; i < INT_SET_BITMAP_WORDS; ++i) {
+            out->bitmap[i] = a->bitmap[i] & b->bitmap[i];
+        }
+        out->cardinality = countBitmap(out->bitmap);
+        return shrinkBitmap(out);
+    }
+
+    if (a->type == INT_SET_BITMAP) {
+        const IntSetContainer * temp = a;
+        a = b;
+        b = temp;
+    }
+
+    if (newArray(out, a->key, a->count) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    uint32_t count = 0;
+
+    if (b->type == INT_SET_BITMAP) {
+        for (uint32_t i = 0; i < a->count; ++i) {
+            if (testBit(b->bitmap, a->array[i])) {
+                out->array[count++] = a->array[i];
+            }
+        }
+    } else {
+        uint32_t i = 0, j = 0;
+        while (i < a->count && j < b->count) {
+            if (a->array[i] < b->array[j]) {
+                i++;
+            } else if (a->array[i] > b->array[j]) {
+                j++;
+            } else {
+                out->array[count++] = a->array[i++];
+                j++;
+            }
+        }
+    }
+
+    out->count = count;
+    out->cardinality = count;
+    return EXIT_SUCCESS;
+}
+
+static int differenceContainers(const IntSetContainer * a, const IntSetContainer * b, IntSetContainer * out) {
+    if (a->type == INT_SET_BITMAP) {
+        if (newBitmap(out, a->key) != EXIT_SUCCESS) {
+            return EXIT_FAILURE;
+        }
+
+        if (b->type == INT_SET_BITMAP) {
+            for (int i = 0; i < INT_SET_BITMAP_WORDS; ++i) {
+                out->bitmap[i] = a->bitmap[i] & ~b->bitmap[i];
+            }
+        } else {
+            memcpy(out->bitmap, a->bitmap, BITMAP_BYTES);
+            for (uint32_t i = 0; i < b->count; ++i) {
+                clearBit(out->bitmap, b->array[i]);
+            }
+        }
+
+        out->cardinality = countBitmap(out->bitmap);
+        return shrinkBitmap(out);
+    }
+
+    if (newArray(out, a->key, a->count) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    uint32_t count = 0;
+
+    if (b->type == INT_SET_BITMAP) {
+        for (uint32_t i = 0; i < a->count; ++i) {
+            if (!testBit(b->bitmap, a->array[i])) {
+                out->array[count++] = a->array[i];
+            }
+        }
+    } else {
+        uint32_t i = 0, j = 0;
+        while (i < a->count) {
+            if (j == b->count || a->array[i] < b->array[j]) {
+                out->array[count++] = a->array[i++];
+            } else if (a->array[i] > b->array[j]) {
+                j++;
+            } else {
+                i++;
+                j++;
+            }
+        }
+    }
+
+    out->count = count;
+    out->cardinality = count;
+    return EXIT_SUCCESS;
+}
+
+/*Walks the containers of both sets in key order; 'keepA' and 'keepB' say whether unmatched containers are copied across*/
+static IntSet * combineIntSets(IntSet * a, IntSet * b, int (*combine)(const IntSetContainer * a, const IntSetContainer * b, IntSetContainer * out), bool keepA, bool keepB) {
+    if (!a || !b) {
+        return NULL;
+    }
+
+    IntSet * result = createIntSet();
+    if (!result) {
+        return NULL;
+    }
+
+    size_t i = 0, j = 0;
+
+    while (i < a->count || j < b->count) {
+        IntSetContainer out;
+        const IntSetContainer * source = NULL;
+
+        if (j == b->count || (i < a->count && a->containers[i].key < b->containers[j].key)) {
+            source = keepA ? &a->containers[i] : NULL;
+            i++;
+        } else if (i == a->count || a->containers[i].key > b->containers[j].key) {
+            source = keepB ? &b->containers[j] : NULL;
+            j++;
+        } else {
+            IntSetContainer scratchA, scratchB;
+            const IntSetContainer * viewA = naturalView(&a->containers[i], &scratchA);
+            const IntSetContainer * viewB = naturalView(&b->containers[j], &scratchB);
+            int status = viewA && viewB ? combine(viewA, viewB, &out) : EXIT_FAILURE;
+
+            if (viewA == &scratchA) {
+                freeContainer(&scratchA);
+            }
+            if (viewB == &scratchB) {
+                freeContainer(&scratchB);
+            }
+
+            if (status != EXIT_SUCCESS || appendContainer(result, &out) != EXIT_SUCCESS) {
+                destroyIntSet(result);
+                return NULL;
+            }
+
+            i++;
+            j++;
+            continue;
+        }
+
+        if (!source) {
+            continue;
+        }
+
+        if (cloneContainer(source, &out) != EXIT_SUCCESS || appendContainer(result, &out) != EXIT_SUCCESS) {
+            destroyIntSet(result);
+            return NULL;
+        }
+    }
+
+    return result;
+}
+
+/*Counts the runs of consecutive values in a container*/
+static uint32_t countRuns(const IntSetContainer * container) {
+    if (container->type == INT_SET_RUN) {
+        return container->count;
+    }
+
+    uint32_t runs = 0;
+
+    if (container->type == INT_SET_ARRAY) {
+        for (uint32_t i = 0; i < container->count; ++i) {
+            if (i == 0 || container->array[i] != container->array[i - 1] + 1) {
+                runs++;
+            }
+        }
+        return runs;
+    }
+
+    /*A run starts at every set bit whose lower neighbour is clear*/
+    uint64_t carry = 0;
+    for (int i = 0; i < INT_SET_BITMAP_WORDS; ++i) {
+        uint64_t word = container->bitmap[i];
+        runs += countBits(word & ~((word << 1) | carry));
+        carry = word >> 63;
+    }
+
+    return runs;
+}
+
+static int toRuns(IntSetContainer * container, uint32_t runCount) {
+    IntSetRun * runs = malloc(sizeof(IntSetRun) * (runCount > 0 ? runCount : 1));
+    if (!runs) {
+        return EXIT_FAILURE;
+    }
+
+    uint32_t count = 0;
+
+    if (container->type == INT_SET_ARRAY) {
+        for (uint32_t i = 0; i < container->count; ++i) {
+            if (i > 0 && container->array[i] == container->array[i - 1] + 1) {
+                runs[count - 1].length++;
+            } else {
+                runs[count].start = container->array[i];
+                runs[count].length = 0;
+                count++;
+            }
+        }
+    } else {
+        bool open = false;
+
+        for (uint32_t low = 0; low < INT_SET_BITMAP_WORDS * 64; ++low) {
+            if (!testBit(container->bitmap, (uint16_t)low)) {
+                open = false;
+            } else if (open) {
+                runs[count - 1].length++;
+            } else {
+                runs[count].start = (uint16_t)low;
+                runs[count].length = 0;
+                count++;
+                open = true;
+            }
+        }
+    }
+
+    free(container->array);
+    container->runs = runs;
+    container->type = INT_SET_RUN;
+    container->count = count;
+    container->capacity = count;
+
+    return EXIT_SUCCESS;
+}
+
+IntSet * createIntSet(void) {
+    IntSet * set = malloc(sizeof(IntSet));
+    if (!set) {
+        return NULL;
+    }
+
+    set->containers = NULL;
+    set->count = 0;
+    set->capacity = 0;
+    set->length = 0;
+
+    return set;
+}
+
+int addIntSet(IntSet * set, int value) {
+    if (!set) {
+        return EXIT_FAILURE;
+    }
+
+    uint32_t bits = toUnsigned(value);
+    uint16_t key = (uint16_t)(bits >> 16);
+    uint16_t low = (uint16_t)bits;
+    size_t index = searchContainers(set, key);
+
+    if (index == set->count || set->containers[index].key != key) {
+        IntSetContainer container;
+        if (newArray(&container, key, 4) != EXIT_SUCCESS) {
+            return EXIT_FAILURE;
+        }
+
+        if (set->count == set->capacity) {
+            size_t capacity = set->capacity > 0 ? set->capacity * 2 : 4;
+            IntSetContainer * containers = realloc(set->containers, sizeof(IntSetContainer) * capacity);
+            if (!containers) {
+                freeContainer(&container);
+                return EXIT_FAILURE;
+            }
+            set->containers = containers;
+            set->capacity = capacity;
+        }
+
+        memmove(&set->containers[index + 1], &set->containers[index], sizeof(IntSetContainer) * (set->count - index));
+        set->containers[index] = container;
+        set->count++;
+    }
+
+    IntSetContainer * container = &set->containers[index];
+
+    if (containerContains(container, low)) {
+        return EXIT_SUCCESS;
+    }
+
+    if (container->type == INT_SET_RUN && runToNatural(container) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    if (container->type == INT_SET_ARRAY && container->count == INT_SET_ARRAY_MAX && arrayToBitmap(container) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    if (container->type == INT_SET_BITMAP) {
+        setBit(container->bitmap, low);
+    } else {
+        if (container->count == container->capacity) {
+            uint32_t capacity = container->capacity * 2;
+            if (reserveArray(container, capacity < INT_SET_ARRAY_MAX ? capacity : INT_SET_ARRAY_MAX) != EXIT_SUCCESS) {
+                return EXIT_FAILURE;
+            }
+        }
+
+        uint32_t position = searchArray(container->array, container->count, low);
+        memmove(&container->array[position + 1], &container->array[position], sizeof(uint16_t) * (container->count - position));
+        container->array[position] = low;
+        container->count++;
+    }
+
+    container->cardinality++;
+    set->length++;
+
+    return EXIT_SUCCESS;
+}
+
+int removeIntSet(IntSet * set, int value) {
+    if (!set) {
+        return EXIT_FAILURE;
+    }
+
+    uint32_t bits = toUnsigned(value);
+    uint16_t key = (uint16_t)(bits >> 16);
+    uint16_t low = (uint16_t)bits;
+    size_t index = searchContainers(set, key);
+
+    if (index == set->count || set->containers[index].key != key) {
+        return EXIT_FAILURE;
+    }
+
+    IntSetContainer * container = &set->containers[index];
+
+    if (!containerContains(container, low)) {
+        return EXIT_FAILURE;
+    }
+
+    if (container->type == INT_SET_RUN && runToNatural(container) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    if (container->type == INT_SET_BITMAP) {
+        clearBit(container->bitmap, low);
+    } else {
+        uint32_t position = searchArray(container->array, container->count, low);
+        memmove(&container->array[position], &container->array[position + 1], sizeof(uint16_t) * (container->count - position - 1));
+        container->count--;
+    }
+
+    container->cardinality--;
+    set->length--;
+
+    if (container->cardinality == 0) {
+        freeContainer(container);
+        memmove(&set->containers[index], &set->containers[index + 1], sizeof(IntSetContainer) * (set->count - index - 1));
+        set->count--;
+    } else if (container->type == INT_SET_BITMAP && container->cardinality <= INT_SET_ARRAY_MAX / 2) {
+        /*Converting back only at half the threshold keeps a container near the boundary from flipping on every call*/
+        bitmapToArray(container);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+bool intSetContains(IntSet * set, int value) {
+    if (!set) {
+        return false;
+    }
+
+    uint32_t bits = toUnsigned(value);
+    uint16_t key = (uint16_t)(bits >> 16);
+    size_t index = searchContainers(set, key);
+
+    if (index == set->count || set->containers[index].key != key) {
+        return false;
+    }
+
+    return containerContains(&set->containers[index], (uint16_t)bits);
+}
+
+size_t getIntSetCardinality(IntSet * set) {
+    if (!set) {
+        return 0;
+    }
+
+    return set->length;
+}
+
+size_t getIntSetMemory(IntSet * set) {
+    if (!set) {
+        return 0;
+    }
+
+    size_t bytes = sizeof(IntSet) + sizeof(IntSetContainer) * set->capacity;
+
+    for (size_t i = 0; i < set->count; ++i) {
+        IntSetContainer * container = &set->containers[i];
+
+        if (container->type == INT_SET_BITMAP) {
+            bytes += BITMAP_BYTES;
+        } else if (container->type == INT_SET_RUN) {
+            bytes += sizeof(IntSetRun) * container->capacity;
+        } else {
+            bytes += sizeof(uint16_t) * container->capacity;
+        }
+    }
+
+    return bytes;
+}
+
+IntSet * unionIntSet(IntSet * a, IntSet * b) {
+    return combineIntSets(a, b, unionContainers, true, true);
+}
+
+IntSet * intersectIntSet(IntSet * a, IntSet * b) {
+    return combineIntSets(a, b, intersectContainers, false, false);
+}
+
+IntSet * differenceIntSet(IntSet * a, IntSet * b) {
+    return combineIntSets(a, b, differenceContainers, true, false);
+}
+
+int optimizeIntSet(IntSet * set) {
+    if (!set) {
+        return EXIT_FAILURE;
+    }
+
+    for (size_t i = 0; i < set->count; ++i) {
+        IntSetContainer * container = &set->containers[i];
+        uint32_t runs = countRuns(container);
+        size_t runBytes = sizeof(IntSetRun) * runs;
+        size_t arrayBytes = sizeof(uint16_t) * container->cardinality;
+        size_t naturalBytes = container->cardinality > INT_SET_ARRAY_MAX ? BITMAP_BYTES : arrayBytes;
+
+        if (container->type == INT_SET_RUN) {
+            if (runBytes > naturalBytes && runToNatural(container) != EXIT_SUCCESS) {
+                return EXIT_FAILURE;
+            }
+        } else if (runBytes < naturalBytes && toRuns(container, runs) != EXIT_SUCCESS) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int destroyIntSet(IntSet * set) {
+    if (!set) {
+        return EXIT_FAILURE;
+    }
+
+    for (size_t i = 0; i < set->count; ++i) {
+        freeContainer(&set->containers[i]);
+    }
+
+    free(set->containers);
+    set->containers = NULL;
+
+    free(set);
+    set = NULL;
+
+    return EXIT_SUCCESS;
+}
+
+char * printIntSet(IntSet * set) {
+    if (!set) {
+        return NULL;
+    }
+
+    /*Every value fits in 11 characters plus a separating space*/
+    char * str = malloc(sizeof(char) * (set->length * 12 + 1));
+    if (!str) {
+        return NULL;
+    }
+    strcpy(str, "");
+
+    IntSetIterator iterator = createIntSetIterator(set);
+    size_t length = 0;
+    int value;
+
+    while (intSetIterateNext(&iterator, &value)) {
+        length += sprintf(&str[length], "%d ", value);
+    }
+
+    return str;
+}
+
+/*Positions the iterator at the start of its current container*/
+static void enterContainer(IntSetIterator * iterator) {
+    iterator->index = 0;
+    iterator->offset = 0;
+    iterator->word = 0;
+
+    if (iterator->container < iterator->set->count) {
+        IntSetContainer * container = &iterator->set->containers[iterator->container];
+        if (container->type == INT_SET_BITMAP) {
+            iterator->word = container->bitmap[0];
+        }
+    }
+}
+
+IntSetIterator createIntSetIterator(IntSet * set) {
+    IntSetIterator iterator;
+
+    iterator.set = set;
+    iterator.container = 0;
+    iterator.index = 0;
+    iterator.offset = 0;
+    iterator.word = 0;
+
+    if (set) {
+        enterContainer(&iterator);
+    }
+
+    return iterator;
+}
+
+bool intSetIterateNext(IntSetIterator * iterator, int * value) {
+    if (!iterator || !iterator->set) {
+        return false;
+    }
+
+    while (iterator->container < iterator->set->count) {
+        IntSetContainer * container = &iterator->set->containers[iterator->container];
+        uint32_t high = (uint32_t)container->key << 16;
+
+        if (container->type == INT_SET_ARRAY) {
+            if (iterator->index < container->count) {
+                *value = toSigned(high | container->array[iterator->index++]);
+                return true;
+            }
+        } else if (container->type == INT_SET_BITMAP) {
+            while (iterator->word == 0 && iterator->index + 1 < INT_SET_BITMAP_WORDS) {
+                iterator->word = container->bitmap[++iterator->index];
+            }
+
+            if (iterator->word) {
+                uint32_t low = iterator->index * 64 + lowestBit(iterator->word);
+                iterator->word &= iterator->word - 1;
+                *value = toSigned(high | low);
+                return true;
+            }
+        } else {
+            if (iterator->index < container->count) {
+                IntSetRun run = container->runs[iterator->index];
+                *value = toSigned(high | (run.start + iterator->offset));
+
+                if (iterator->offset == run.length) {
+                    iterator->index++;
+                    iterator->offset = 0;
+                } else {
+                    iterator->offset++;
+                }
+                return true;
+            }
+        }
+
+        iterator->container++;
+        enterContainer(iterator);
+    }
+
+    return false;
+}
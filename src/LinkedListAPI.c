@@ -5,6 +5,11 @@
  **/
 
 #include "LinkedListAPI.h"
+#include "ReclamationAPI.h"
+
+static int destroyListJob(void * structure) {
+    return destroyList(structure);
+}
 
 ListNode * createListNode(void * data) {
     ListNode * node = malloc(sizeof(ListNode));
@@ -19,19 +24,40 @@ ListNode * createListNode(void * data) {
     return node;
 }
 
-List * createList(char * (*printData)(void * data), void (*destroyData)(void * data), int (*compareData)(const void * a, const void * b)) {
+/*Allocates a node for the list, copying the value in behind the node when the list stores values inline*/
+static ListNode * createNodeFor(List * list, void * data) {
+    if (list->valueSize == 0) {
+        return createListNode(data);
+    }
+
+    ListNode * node = malloc(sizeof(ListNode) + list->valueSize);
+    if (!node) {
+        return NULL;
+    }
+
+    node->data = node + 1;
+    memcpy(node->data, data, list->valueSize);
+    node->next = NULL;
+    node->prev = NULL;
+
+    return node;
+}
+
+/*Shared by the constructors; 'destroyData' is only required when values are held by pointer*/
+static List * initList(size_t valueSize, char * (*printData)(void * data), void (*destroyData)(void * data), int (*compareData)(const void * a, const void * b)) {
     List * list = malloc(sizeof(List));
     if (!list) {
         return NULL;
     }
 
     assert(printData);
-    assert(destroyData);
+    assert(destroyData || valueSize > 0);
     assert(compareData);
 
     list->head = NULL;
     list->tail = NULL;
     list->length = 0;
+    list->valueSize = valueSize;
     list->printData = printData;
     list->destroyData = destroyData;
     list->compareData = compareData;
@@ -39,12 +65,24 @@ List * createList(char * (*printData)(void * data), void (*destroyData)(void * d
     return list;
 }
 
+List * createList(char * (*printData)(void * data), void (*destroyData)(void * data), int (*compareData)(const void * a, const void * b)) {
+    return initList(0, printData, destroyData, compareData);
+}
+
+List * createListInline(size_t valueSize, char * (*printData)(void * data), int (*compareData)(const void * a, const void * b)) {
+    if (valueSize == 0) {
+        return NULL;
+    }
+
+    return initList(valueSize, printData, NULL, compareData);
+}
+
 int insertListFront(List * list, void * data) {
-    if (!list) {
+    if (!list || (list->valueSize > 0 && !data)) {
         return EXIT_FAILURE;
     }
 
-    ListNode * node = createListNode(data);
+    ListNode * node = createNodeFor(list, data);
     if (!node) {
         return EXIT_FAILURE;
     }
@@ -65,11 +103,11 @@ int insertListFront(List * list, void * data) {
 }
 
 int insertListBack(List * list, void * data) {
-    if (!list) {
+    if (!list || (list->valueSize > 0 && !data)) {
         return EXIT_FAILURE;
     }
 
-    ListNode * node = createListNode(data);
+    ListNode * node = createNodeFor(list, data);
     if (!node) {
         return EXIT_FAILURE;
     }
@@ -90,7 +128,7 @@ int insertListBack(List * list, void * data) {
 }
 
 int insertSortedList(List * list, void * data) {
-    if (!list) {
+    if (!list || (list->valueSize > 0 && !data)) {
         return EXIT_FAILURE;
     }
 
@@ -106,14 +144,15 @@ int insertSortedList(List * list, void * data) {
         return insertListBack(list, data);
     }
 
-    ListNode * node = createListNode(data);
+    ListNode * node = createNodeFor(list, data);
     if (!node) {
         return EXIT_FAILURE;
     }
     ListNode * temp = list->head;
 
     while (temp) {
-        if (list->compareData(data, temp->data) > 0 || list->compareData(data, temp->next->data) <= 0) {
+        /*Every node up to 'temp' compares no higher than 'data', so it belongs before the first one that is higher*/
+        if (list->compareData(data, temp->next->data) < 0) {
             node->next = temp->next;
             temp->next->prev = node;
             node->prev = temp;
@@ -143,7 +182,9 @@ int destroyList(List * list) {
 
         temp->next = NULL;
         temp->prev = NULL;
-        list->destroyData(temp->data);
+        if (list->valueSize == 0) {
+            list->destroyData(temp->data);
+        }
         free(temp);
     }
 
@@ -153,6 +194,14 @@ int destroyList(List * list) {
     return EXIT_SUCCESS;
 }
 
+int destroyListAsync(List * list) {
+    if (!list) {
+        return EXIT_FAILURE;
+    }
+
+    return deferReclamation(destroyListJob, list);
+}
+
 int removeListFront(List * list) {
     if (!list || list->length == 0) {
         return EXIT_FAILURE;
@@ -162,9 +211,13 @@ int removeListFront(List * list) {
     list->head = temp->next;
     if (list->head) {
         list->head->prev = NULL;
+    } else {
+        list->tail = NULL;
     }
 
-    list->destroyData(temp->data);
+    if (list->valueSize == 0) {
+        list->destroyData(temp->data);
+    }
     free(temp);
     temp = NULL;
     list->length--;
@@ -178,12 +231,16 @@ int removeListBack(List * list) {
     }
 
     ListNode * temp = list->tail;
-    list->head = temp->prev;
+    list->tail = temp->prev;
     if (list->tail) {
         list->tail->next = NULL;
+    } else {
+        list->head = NULL;
     }
 
-    list->destroyData(temp->data);
+    if (list->valueSize == 0) {
+        list->destroyData(temp->data);
+    }
     free(temp);
     temp = NULL;
     list->length--;
@@ -206,6 +263,8 @@ int removeFromList(List * list, void * data) {
                 list->head = temp->next;
                 if (list->head) {
                     list->head->prev = NULL;
+                } else {
+                    list->tail = NULL;
                 }
             } else if (temp == list->tail) {
                 list->tail = temp->prev;
@@ -217,7 +276,9 @@ int removeFromList(List * list, void * data) {
                 temp->next->prev = temp->prev;
             }
 
-            list->destroyData(temp->data);
+            if (list->valueSize == 0) {
+                list->destroyData(temp->data);
+            }
             free(temp);
             temp = NULL;
             list->length--;
@@ -402,3 +463,138 @@ int resetListIterator(ListIterator * iterator) {
     iterator->currentNode = iterator->list->head;
     return EXIT_SUCCESS;
 }
+
+/*Detaches the nodes 'first' through 'last' from 'list' without freeing them*/
+static void unlinkRange(List * list, ListNode * first, ListNode * last, size_t count) {
+    if (first->prev) {
+        first->prev->next = last->next;
+    } else {
+        list->head = last->next;
+    }
+
+    if (last->next) {
+        last->next->prev = first->prev;
+    } else {
+        list->tail = first->prev;
+    }
+
+    first->prev = NULL;
+    last->next = NULL;
+    list->length -= count;
+}
+
+/*Links the detached nodes 'first' through 'last' into 'list' before 'position', or at the back if it is NULL*/
+static void linkRange(List * list, ListNode * position, ListNode * first, ListNode * last, size_t count) {
+    if (!position) {
+        first->prev = list->tail;
+        if (list->tail) {
+            list->tail->next = first;
+        } else {
+            list->head = first;
+        }
+        list->tail = last;
+    } else {
+        first->prev = position->prev;
+        last->next = position;
+        if (position->prev) {
+            position->prev->next = first;
+        } else {
+            list->head = first;
+        }
+        position->prev = last;
+    }
+
+    list->length += count;
+}
+
+int listConcat(List * dest, List * src) {
+    if (!dest || !src || dest == src || dest->valueSize != src->valueSize) {
+        return EXIT_FAILURE;
+    }
+
+    if (src->length == 0) {
+        return EXIT_SUCCESS;
+    }
+
+    linkRange(dest, NULL, src->head, src->tail, src->length);
+
+    src->head = NULL;
+    src->tail = NULL;
+    src->length = 0;
+
+    return EXIT_SUCCESS;
+}
+
+List * listSplitAt(ListIterator * iterator) {
+    if (!iterator || !iterator->list) {
+        return NULL;
+    }
+
+    List * list = iterator->list;
+    List * split = initList(list->valueSize, list->printData, list->destroyData, list->compareData);
+    if (!split) {
+        return NULL;
+    }
+
+    ListNode * first = iterator->currentNode;
+    if (!first) {
+        return split;
+    }
+
+    size_t count = 0;
+    for (ListNode * temp = first; temp; temp = temp->next) {
+        count++;
+    }
+
+    ListNode * last = list->tail;
+    unlinkRange(list, first, last, count);
+    linkRange(split, NULL, first, last, count);
+
+    iterator->list = split;
+
+    return split;
+}
+
+int listSpliceRange(List * dest, ListNode * position, List * src, ListNode * first, ListNode * last) {
+    if (!dest || !src || !first || !last || dest->valueSize != src->valueSize) {
+        return EXIT_FAILURE;
+    }
+
+    size_t count = 0;
+    ListNode * temp = first;
+    while (temp) {
+        if (temp == position) {
+            return EXIT_FAILURE;
+        }
+        count++;
+        if (temp == last) {
+            break;
+        }
+        temp = temp->next;
+    }
+
+    /*'last' was not reached by walking forward from 'first'*/
+    if (!temp) {
+        return EXIT_FAILURE;
+    }
+
+    unlinkRange(src, first, last, count);
+    linkRange(dest, position, first, last, count);
+
+    return EXIT_SUCCESS;
+}
+
+int listMoveToFront(List * list, ListNode * node) {
+    if (!list || !node || list->length == 0) {
+        return EXIT_FAILURE;
+    }
+
+    if (node == list->head) {
+        return EXIT_SUCCESS;
+    }
+
+    unlinkRange(list, node, node, 1);
+    linkRange(list, list->head, node, node, 1);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,762 @@
+/**
+ * @file OrderedMapAPI.c
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Function implementations for an ordered map backed by a B+ tree
+ **/
+
+#include "OrderedMapAPI.h"
+
+#define LEAF_MIN_KEYS (ORDERED_MAP_LEAF_KEYS / 2)
+#define INNER_MIN_KEYS (ORDERED_MAP_INNER_KEYS / 2)
+
+/*Returns the index of the first key that is greater than or equal to 'key'*/
+static int lowerBound(const int * keys, int count, int key) {
+    int low = 0, high = count;
+
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (keys[mid] < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/*Returns the index of the first key that is greater than 'key'*/
+static int upperBound(const int * keys, int count, int key) {
+    int low = 0, high = count;
+
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (keys[mid] <= key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/*Nodes are sized as whole cache lines, which the alignment of their headers also makes them a multiple of*/
+static OrderedMapLeaf * createLeaf(void) {
+    OrderedMapLeaf * leaf = aligned_alloc(ORDERED_MAP_CACHE_LINE, sizeof(OrderedMapLeaf));
+    if (!leaf) {
+        return NULL;
+    }
+
+    leaf->header.count = 0;
+    leaf->header.isLeaf = true;
+    leaf->prev = NULL;
+    leaf->next = NULL;
+
+    return leaf;
+}
+
+static OrderedMapInner * createInner(void) {
+    OrderedMapInner * inner = aligned_alloc(ORDERED_MAP_CACHE_LINE, sizeof(OrderedMapInner));
+    if (!inner) {
+        return NULL;
+    }
+
+    inner->header.count = 0;
+    inner->header.isLeaf = false;
+
+    return inner;
+}
+
+/*Frees a subtree, destroying its data only if 'destroyData' is given*/
+static void freeNodes(OrderedMapNode * node, void (*destroyData)(void * data)) {
+    if (node->isLeaf) {
+        OrderedMapLeaf * leaf = (OrderedMapLeaf *)node;
+        if (destroyData) {
+            for (int i = 0; i < node->count; ++i) {
+                destroyData(leaf->data[i]);
+            }
+        }
+    } else {
+        OrderedMapInner * inner = (OrderedMapInner *)node;
+        for (int i = 0; i <= node->count; ++i) {
+            freeNodes(inner->children[i], destroyData);
+        }
+    }
+
+    free(node);
+}
+
+/*Descends from the root to the leaf whose key range covers 'key'*/
+static OrderedMapLeaf * findLeaf(OrderedMap * map, int key) {
+    OrderedMapNode * node = map->root;
+
+    while (!node->isLeaf) {
+        OrderedMapInner * inner = (OrderedMapInner *)node;
+        node = inner->children[upperBound(inner->keys, node->count, key)];
+    }
+
+    return (OrderedMapLeaf *)node;
+}
+
+/*
+ * Nodes allocated up front for one insertion, so that a split never has to allocate
+ * part way up the tree. Spare inner nodes are chained through 'children[0]'
+ */
+typedef struct SplitSpares {
+    OrderedMapLeaf * leaf;
+    OrderedMapInner * inners;
+} SplitSpares;
+
+static OrderedMapInner * takeSpareInner(SplitSpares * spares) {
+    OrderedMapInner * inner = spares->inners;
+    spares->inners = (OrderedMapInner *)inner->children[0];
+
+    return inner;
+}
+
+static void freeSpares(SplitSpares * spares) {
+    free(spares->leaf);
+    spares->leaf = NULL;
+
+    while (spares->inners) {
+        free(takeSpareInner(spares));
+    }
+}
+
+/*
+ * Allocates every node that inserting 'key' will need. A split climbs from the leaf through each
+ * full ancestor in turn, and needs a new root if it climbs past the old one
+ */
+static int reserveSplits(OrderedMap * map, int key, SplitSpares * spares) {
+    spares->leaf = NULL;
+    spares->inners = NULL;
+
+    OrderedMapNode * node = map->root;
+    int depth = 0;
+    int fullRun = 0;
+
+    while (!node->isLeaf) {
+        OrderedMapInner * inner = (OrderedMapInner *)node;
+        fullRun = node->count == ORDERED_MAP_INNER_KEYS ? fullRun + 1 : 0;
+        depth++;
+        node = inner->children[upperBound(inner->keys, node->count, key)];
+    }
+
+    OrderedMapLeaf * leaf = (OrderedMapLeaf *)node;
+    int index = lowerBound(leaf->keys, node->count, key);
+    if (node->count < ORDERED_MAP_LEAF_KEYS || (index < node->count && leaf->keys[index] == key)) {
+        return EXIT_SUCCESS;
+    }
+
+    spares->leaf = createLeaf();
+    if (!spares->leaf) {
+        return EXIT_FAILURE;
+    }
+
+    int inners = fullRun == depth ? fullRun + 1 : fullRun;
+    for (int i = 0; i < inners; ++i) {
+        OrderedMapInner * inner = createInner();
+        if (!inner) {
+            freeSpares(spares);
+            return EXIT_FAILURE;
+        }
+
+        inner->children[0] = (OrderedMapNode *)spares->inners;
+        spares->inners = inner;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+static void insertLeaf(OrderedMap * map, OrderedMapLeaf * leaf, int key, void * data, SplitSpares * spares, int * splitKey, OrderedMapNode ** splitNode) {
+    int count = leaf->header.count;
+    int index = lowerBound(leaf->keys, count, key);
+
+    if (index < count && leaf->keys[index] == key) {
+        if (leaf->data[index] != data) {
+            map->destroyData(leaf->data[index]);
+            leaf->data[index] = data;
+        }
+        return;
+    }
+
+    if (count < ORDERED_MAP_LEAF_KEYS) {
+        memmove(&leaf->keys[index + 1], &leaf->keys[index], sizeof(int) * (count - index));
+        memmove(&leaf->data[index + 1], &leaf->data[index], sizeof(void *) * (count - index));
+        leaf->keys[index] = key;
+        leaf->data[index] = data;
+        leaf->header.count++;
+        map->length++;
+        return;
+    }
+
+    OrderedMapLeaf * right = spares->leaf;
+    spares->leaf = NULL;
+
+    int keys[ORDERED_MAP_LEAF_KEYS + 1];
+    void * values[ORDERED_MAP_LEAF_KEYS + 1];
+
+    memcpy(keys, leaf->keys, sizeof(int) * index);
+    memcpy(values, leaf->data, sizeof(void *) * index);
+    keys[index] = key;
+    values[index] = data;
+    memcpy(&keys[index + 1], &leaf->keys[index], sizeof(int) * (count - index));
+    memcpy(&values[index + 1], &leaf->data[index], sizeof(void *) * (count - index));
+
+    int leftCount = (ORDERED_MAP_LEAF_KEYS + 1) / 2;
+    int rightCount = ORDERED_MAP_LEAF_KEYS + 1 - leftCount;
+
+    memcpy(leaf->keys, keys, sizeof(int) * leftCount);
+    memcpy(leaf->data, values, sizeof(void *) * leftCount);
+    leaf->header.count = leftCount;
+
+    memcpy(right->keys, &keys[leftCount], sizeof(int) * rightCount);
+    memcpy(right->data, &values[leftCount], sizeof(void *) * rightCount);
+    right->header.count = rightCount;
+
+    right->next = leaf->next;
+    right->prev = leaf;
+    if (leaf->next) {
+        leaf->next->prev = right;
+    }
+    leaf->next = right;
+
+    map->length++;
+    *splitKey = right->keys[0];
+    *splitNode = (OrderedMapNode *)right;
+}
+
+/*Inserts into the subtree; any split it causes takes its nodes from 'spares', which 'reserveSplits' filled*/
+static void insertNode(OrderedMap * map, OrderedMapNode * node, int key, void * data, SplitSpares * spares, int * splitKey, OrderedMapNode ** splitNode) {
+    *splitNode = NULL;
+
+    if (node->isLeaf) {
+        insertLeaf(map, (OrderedMapLeaf *)node, key, data, spares, splitKey, splitNode);
+        return;
+    }
+
+    OrderedMapInner * inner = (OrderedMapInner *)node;
+    int index = upperBound(inner->keys, node->count, key);
+    int childKey;
+    OrderedMapNode * childNode;
+
+    insertNode(map, inner->children[index], key, data, spares, &childKey, &childNode);
+    if (!childNode) {
+        return;
+    }
+
+    int count = node->count;
+
+    if (count < ORDERED_MAP_INNER_KEYS) {
+        memmove(&inner->keys[index + 1], &inner->keys[index], sizeof(int) * (count - index));
+        memmove(&inner->children[index + 2], &inner->children[index + 1], sizeof(OrderedMapNode *) * (count - index));
+        inner->keys[index] = childKey;
+        inner->children[index + 1] = childNode;
+        node->count++;
+        return;
+    }
+
+    OrderedMapInner * right = takeSpareInner(spares);
+
+    int keys[ORDERED_MAP_INNER_KEYS + 1];
+    OrderedMapNode * children[ORDERED_MAP_INNER_KEYS + 2];
+
+    memcpy(keys, inner->keys, sizeof(int) * index);
+    keys[index] = childKey;
+    memcpy(&keys[index + 1], &inner->keys[index], sizeof(int) * (count - index));
+
+    memcpy(children, inner->children, sizeof(OrderedMapNode *) * (index + 1));
+    children[index + 1] = childNode;
+    memcpy(&children[index + 2], &inner->children[index + 1], sizeof(OrderedMapNode *) * (count - index));
+
+    /*The middle key moves up to the parent and is kept by neither half*/
+    int leftCount = (ORDERED_MAP_INNER_KEYS + 1) / 2;
+    int rightCount = ORDERED_MAP_INNER_KEYS - leftCount;
+
+    memcpy(inner->keys, keys, sizeof(int) * leftCount);
+    memcpy(inner->children, children, sizeof(OrderedMapNode *) * (leftCount + 1));
+    node->count = leftCount;
+
+    memcpy(right->keys, &keys[leftCount + 1], sizeof(int) * rightCount);
+    memcpy(right->children, &children[leftCount + 1], sizeof(OrderedMapNode *) * (rightCount + 1));
+    right->header.count = rightCount;
+
+    *splitKey = keys[leftCount];
+    *splitNode = (OrderedMapNode *)right;
+}
+
+/*Removes the separator at 'index' and the child to its right from an inner node*/
+static void removeSeparator(OrderedMapInner * inner, int index) {
+    int count = inner->header.count;
+
+    memmove(&inner->keys[index], &inner->keys[index + 1], sizeof(int) * (count - index - 1));
+    memmove(&inner->children[index + 1], &inner->children[index + 2], sizeof(OrderedMapNode *) * (count - index - 1));
+    inner->header.count--;
+}
+
+static void fixLeaf(OrderedMapInner * parent, int index) {
+    OrderedMapLeaf * child = (OrderedMapLeaf *)parent->children[index];
+    OrderedMapLeaf * left = index > 0 ? (OrderedMapLeaf *)parent->children[index - 1] : NULL;
+    OrderedMapLeaf * right = index < parent->header.count ? (OrderedMapLeaf *)parent->children[index + 1] : NULL;
+    int count = child->header.count;
+
+    if (left && left->header.count > LEAF_MIN_KEYS) {
+        int last = --left->header.count;
+        memmove(&child->keys[1], child->keys, sizeof(int) * count);
+        memmove(&child->data[1], child->data, sizeof(void *) * count);
+        child->keys[0] = left->keys[last];
+        child->data[0] = left->data[last];
+        child->header.count++;
+        parent->keys[index - 1] = child->keys[0];
+    } else if (right && right->header.count > LEAF_MIN_KEYS) {
+        child->keys[count] = right->keys[0];
+        child->data[count] = right->data[0];
+        child->header.count++;
+        right->header.count--;
+        memmove(right->keys, &right->keys[1], sizeof(int) * right->header.count);
+        memmove(right->data, &right->data[1], sizeof(void *) * right->header.count);
+        parent->keys[index] = right->keys[0];
+    } else {
+        /*Neither sibling can spare a key, so merge the right one of the pair into the left one*/
+        if (left) {
+            right = child;
+            index--;
+        } else {
+            left = child;
+        }
+
+        memcpy(&left->keys[left->header.count], right->keys, sizeof(int) * right->header.count);
+        memcpy(&left->data[left->header.count], right->data, sizeof(void *) * right->header.count);
+        left->header.count += right->header.count;
+
+        left->next = right->next;
+        if (right->next) {
+            right->next->prev = left;
+        }
+        free(right);
+
+        removeSeparator(parent, index);
+    }
+}
+
+static void fixInner(OrderedMapInner * parent, int index) {
+    OrderedMapInner * child = (OrderedMapInner *)parent->children[index];
+    OrderedMapInner * left = index > 0 ? (OrderedMapInner *)parent->children[index - 1] : NULL;
+    OrderedMapInner * right = index < parent->header.count ? (OrderedMapInner *)parent->children[index + 1] : NULL;
+    int count = child->header.count;
+
+    if (left && left->header.count > INNER_MIN_KEYS) {
+        int last = left->header.count;
+        memmove(&child->keys[1], child->keys, sizeof(int) * count);
+        memmove(&child->children[1], child->children, sizeof(OrderedMapNode *) * (count + 1));
+        child->keys[0] = parent->keys[index - 1];
+        child->children[0] = left->children[last];
+        child->header.count++;
+        parent->keys[index - 1] = left->keys[last - 1];
+        left->header.count--;
+    } else if (right && right->header.count > INNER_MIN_KEYS) {
+        child->keys[count] = parent->keys[index];
+        child->children[count + 1] = right->children[0];
+        child->header.count++;
+        parent->keys[index] = right->keys[0];
+        right->header.count--;
+        memmove(right->keys, &right->keys[1], sizeof(int) * right->header.count);
+        memmove(right->children, &right->children[1], sizeof(OrderedMapNode *) * (right->header.count + 1));
+    } else {
+        if (left) {
+            right = child;
+            index--;
+        } else {
+            left = child;
+        }
+
+        /*The separator comes down from the parent between the two halves*/
+        int leftCount = left->header.count;
+        left->keys[leftCount] = parent->keys[index];
+        memcpy(&left->keys[leftCount + 1], right->keys, sizeof(int) * right->header.count);
+        memcpy(&left->children[leftCount + 1], right->children, sizeof(OrderedMapNode *) * (right->header.count + 1));
+        left->header.count += 1 + right->header.count;
+        free(right);
+
+        removeSeparator(parent, index);
+    }
+}
+
+static int removeNode(OrderedMap * map, OrderedMapNode * node, int key) {
+    if (node->isLeaf) {
+        OrderedMapLeaf * leaf = (OrderedMapLeaf *)node;
+        int index = lowerBound(leaf->keys, node->count, key);
+
+        if (index == node->count || leaf->keys[index] != key) {
+            return EXIT_FAILURE;
+        }
+
+        map->destroyData(leaf->data[index]);
+        node->count--;
+        memmove(&leaf->keys[index], &leaf->keys[index + 1], sizeof(int) * (node->count - index));
+        memmove(&leaf->data[index], &leaf->data[index + 1], sizeof(void *) * (node->count - index));
+        map->length--;
+
+        return EXIT_SUCCESS;
+    }
+
+    OrderedMapInner * inner = (OrderedMapInner *)node;
+    int index = upperBound(inner->keys, node->count, key);
+    OrderedMapNode * child = inner->children[index];
+
+    if (removeNode(map, child, key) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    if (child->isLeaf && child->count < LEAF_MIN_KEYS) {
+        fixLeaf(inner, index);
+    } else if (!child->isLeaf && child->count < INNER_MIN_KEYS) {
+        fixInner(inner, index);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+OrderedMap * createOrderedMap(char * (*printData)(void * data), void (*destroyData)(void * data)) {
+    OrderedMap * map = malloc(sizeof(OrderedMap));
+    if (!map) {
+        return NULL;
+    }
+
+    assert(printData);
+    assert(destroyData);
+
+    map->root = (OrderedMapNode *)createLeaf();
+    if (!map->root) {
+        free(map);
+        return NULL;
+    }
+
+    map->length = 0;
+    map->printData = printData;
+    map->destroyData = destroyData;
+
+    return map;
+}
+
+OrderedMap * bulkLoadOrderedMap(const int * keys, void ** data, size_t length, char * (*printData)(void * data), void (*destroyData)(void * data)) {
+    if (length > 0 && (!keys || !data)) {
+        return NULL;
+    }
+
+    for (size_t i = 1; i < length; ++i) {
+        if (keys[i - 1] >= keys[i]) {
+            return NULL;
+        }
+    }
+
+    OrderedMap * map = createOrderedMap(printData, destroyData);
+    if (!map || length == 0) {
+        return map;
+    }
+    free(map->root);
+    map->root = NULL;
+
+    /*Spread the keys evenly so that every node, including the last on each level, is at least half full*/
+    size_t levelCount = (length + ORDERED_MAP_LEAF_KEYS - 1) / ORDERED_MAP_LEAF_KEYS;
+    OrderedMapNode ** level = malloc(sizeof(OrderedMapNode *) * levelCount);
+    int * mins = malloc(sizeof(int) * levelCount);
+    if (!level || !mins) {
+        free(level);
+        free(mins);
+        free(map);
+        return NULL;
+    }
+
+    size_t next = 0;
+    OrderedMapLeaf * prev = NULL;
+
+    for (size_t i = 0; i < levelCount; ++i) {
+        OrderedMapLeaf * leaf = createLeaf();
+        if (!leaf) {
+            for (size_t j = 0; j < i; ++j) {
+                free(level[j]);
+            }
+            free(level);
+            free(mins);
+            free(map);
+            return NULL;
+        }
+
+        size_t count = length / levelCount + (i < length % levelCount ? 1 : 0);
+        memcpy(leaf->keys, &keys[next], sizeof(int) * count);
+        memcpy(leaf->data, &data[next], sizeof(void *) * count);
+        leaf->header.count = (int)count;
+        next += count;
+
+        leaf->prev = prev;
+        if (prev) {
+            prev->next = leaf;
+        }
+        prev = leaf;
+
+        level[i] = (OrderedMapNode *)leaf;
+        mins[i] = leaf->keys[0];
+    }
+
+    /*Build each level of inner nodes in place over the one below it*/
+    while (levelCount > 1) {
+        size_t groups = (levelCount + ORDERED_MAP_INNER_KEYS) / (ORDERED_MAP_INNER_KEYS + 1);
+        size_t child = 0;
+
+        for (size_t i = 0; i < groups; ++i) {
+            OrderedMapInner * inner = createInner();
+            if (!inner) {
+                for (size_t j = 0; j < i; ++j) {
+                    freeNodes(level[j], NULL);
+                }
+                for (size_t j = child; j < levelCount; ++j) {
+                    freeNodes(level[j], NULL);
+                }
+                free(level);
+                free(mins);
+                free(map);
+                return NULL;
+            }
+
+            size_t count = levelCount / groups + (i < levelCount % groups ? 1 : 0);
+            int min = mins[child];
+
+            for (size_t j = 0; j < count; ++j) {
+                inner->children[j] = level[child + j];
+                if (j > 0) {
+                    inner->keys[j - 1] = mins[child + j];
+                }
+            }
+            inner->header.count = (int)count - 1;
+            child += count;
+
+            level[i] = (OrderedMapNode *)inner;
+            mins[i] = min;
+        }
+
+        levelCount = groups;
+    }
+
+    map->root = level[0];
+    map->length = length;
+
+    free(level);
+    free(mins);
+
+    return map;
+}
+
+int insertOrderedMap(OrderedMap * map, int key, void * data) {
+    if (!map) {
+        return EXIT_FAILURE;
+    }
+
+    /*Allocating first means a failure leaves the tree exactly as it was*/
+    SplitSpares spares;
+    if (reserveSplits(map, key, &spares) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    int splitKey;
+    OrderedMapNode * splitNode;
+
+    insertNode(map, map->root, key, data, &spares, &splitKey, &splitNode);
+
+    if (splitNode) {
+        OrderedMapInner * root = takeSpareInner(&spares);
+        root->keys[0] = splitKey;
+        root->children[0] = map->root;
+        root->children[1] = splitNode;
+        root->header.count = 1;
+        map->root = (OrderedMapNode *)root;
+    }
+
+    /*Every spare is used by the splits it was reserved for; this only guards against a miscount*/
+    assert(!spares.leaf && !spares.inners);
+    freeSpares(&spares);
+
+    return EXIT_SUCCESS;
+}
+
+int removeOrderedMap(OrderedMap * map, int key) {
+    if (!map || map->length == 0) {
+        return EXIT_FAILURE;
+    }
+
+    if (removeNode(map, map->root, key) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    if (!map->root->isLeaf && map->root->count == 0) {
+        OrderedMapNode * root = map->root;
+        map->root = ((OrderedMapInner *)root)->children[0];
+        free(root);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+void * lookupOrderedMap(OrderedMap * map, int key) {
+    if (!map) {
+        return NULL;
+    }
+
+    OrderedMapLeaf * leaf = findLeaf(map, key);
+    int index = lowerBound(leaf->keys, leaf->header.count, key);
+
+    if (index < leaf->header.count && leaf->keys[index] == key) {
+        return leaf->data[index];
+    }
+
+    return NULL;
+}
+
+bool orderedMapContains(OrderedMap * map, int key) {
+    if (!map) {
+        return false;
+    }
+
+    OrderedMapLeaf * leaf = findLeaf(map, key);
+    int index = lowerBound(leaf->keys, leaf->header.count, key);
+
+    return index < leaf->header.count && leaf->keys[index] == key;
+}
+
+int destroyOrderedMap(OrderedMap * map) {
+    if (!map) {
+        return EXIT_FAILURE;
+    }
+
+    freeNodes(map->root, map->destroyData);
+    map->root = NULL;
+
+    free(map);
+    map = NULL;
+
+    return EXIT_SUCCESS;
+}
+
+char * printOrderedMap(OrderedMap * map) {
+    if (!map) {
+        return NULL;
+    }
+
+    char * str = malloc(sizeof(char));
+    if (!str) {
+        return NULL;
+    }
+    strcpy(str, "");
+    char * tempPtr, * tempStr;
+
+    OrderedMapIterator iterator = createOrderedMapIterator(map, INT_MIN, INT_MAX);
+    void * data;
+
+    while (orderedMapIterateNext(&iterator, NULL, &data)) {
+        tempStr = map->printData(data);
+
+        tempPtr = realloc(str, sizeof(char) * (strlen(str) + strlen(tempStr) + 2));
+        if (!tempPtr) {
+            free(str);
+            free(tempStr);
+            return NULL;
+        }
+        str = tempPtr;
+
+        strcat(str, tempStr);
+        free(tempStr);
+    }
+
+    return str;
+}
+
+OrderedMapIterator createOrderedMapIterator(OrderedMap * map, int low, int high) {
+    OrderedMapIterator iterator;
+
+    iterator.leaf = NULL;
+    iterator.index = 0;
+    iterator.low = low;
+    iterator.high = high;
+    iterator.reverse = false;
+
+    if (!map || low > high) {
+        return iterator;
+    }
+
+    OrderedMapLeaf * leaf = findLeaf(map, low);
+    int index = lowerBound(leaf->keys, leaf->header.count, low);
+
+    /*Every key in this leaf is below 'low', so the range starts at the next one*/
+    if (index == leaf->header.count) {
+        leaf = leaf->next;
+        index = 0;
+    }
+
+    iterator.leaf = leaf;
+    iterator.index = index;
+
+    return iterator;
+}
+
+OrderedMapIterator createOrderedMapReverseIterator(OrderedMap * map, int low, int high) {
+    OrderedMapIterator iterator;
+
+    iterator.leaf = NULL;
+    iterator.index = 0;
+    iterator.low = low;
+    iterator.high = high;
+    iterator.reverse = true;
+
+    if (!map || low > high) {
+        return iterator;
+    }
+
+    OrderedMapLeaf * leaf = findLeaf(map, high);
+    int index = upperBound(leaf->keys, leaf->header.count, high) - 1;
+
+    if (index < 0) {
+        leaf = leaf->prev;
+        index = leaf ? leaf->header.count - 1 : 0;
+    }
+
+    iterator.leaf = leaf;
+    iterator.index = index;
+
+    return iterator;
+}
+
+bool orderedMapIterateNext(OrderedMapIterator * iterator, int * key, void ** data) {
+    if (!iterator || !iterator->leaf) {
+        return false;
+    }
+
+    OrderedMapLeaf * leaf = iterator->leaf;
+    int current = leaf->keys[iterator->index];
+
+    if (iterator->reverse ? current < iterator->low : current > iterator->high) {
+        iterator->leaf = NULL;
+        return false;
+    }
+
+    if (key) {
+        *key = current;
+    }
+    if (data) {
+        *data = leaf->data[iterator->index];
+    }
+
+    if (iterator->reverse) {
+        if (--iterator->index < 0) {
+            iterator->leaf = leaf->prev;
+            iterator->index = leaf->prev ? leaf->prev->header.count - 1 : 0;
+        }
+    } else {
+        if (++iterator->index == leaf->header.count) {
+            iterator->leaf = leaf->next;
+            iterator->index = 0;
+        }
+    }
+
+    return true;
+}
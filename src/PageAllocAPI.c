@@ -0,0 +1,76 @@
+/**
+ * @file PageAllocAPI.c
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Function implementations for allocating large blocks directly from the operating system
+ **/
+
+#define _DEFAULT_SOURCE
+
+#include "PageAllocAPI.h"
+
+#include <stdint.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*Rounds a block up to whole pages of the size its mapping will use, so that freeing can recompute it*/
+static size_t mappedLength(size_t bytes, bool hugePages) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+
+    if (hugePages && bytes >= PAGE_ALLOC_HUGE_PAGE_SIZE) {
+        page = PAGE_ALLOC_HUGE_PAGE_SIZE;
+    }
+
+    return (bytes + page - 1) / page * page;
+}
+
+void * allocatePages(size_t bytes, bool hugePages) {
+    if (bytes == 0) {
+        return NULL;
+    }
+
+    size_t length = mappedLength(bytes, hugePages);
+
+    if (!hugePages || bytes < PAGE_ALLOC_HUGE_PAGE_SIZE) {
+        void * memory = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return memory == MAP_FAILED ? NULL : memory;
+    }
+
+#ifdef MAP_HUGETLB
+    void * reserved = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (reserved != MAP_FAILED) {
+        return reserved;
+    }
+#endif
+
+    /*No reserved huge pages; map extra so the block can start on a huge page boundary, then trim*/
+    size_t padded = length + PAGE_ALLOC_HUGE_PAGE_SIZE;
+    char * memory = mmap(NULL, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return NULL;
+    }
+
+    uintptr_t start = ((uintptr_t)memory + PAGE_ALLOC_HUGE_PAGE_SIZE - 1) & ~(uintptr_t)(PAGE_ALLOC_HUGE_PAGE_SIZE - 1);
+    char * aligned = (char *)start;
+
+    if (aligned > memory) {
+        munmap(memory, aligned - memory);
+    }
+    if (memory + padded > aligned + length) {
+        munmap(aligned + length, memory + padded - (aligned + length));
+    }
+
+#ifdef MADV_HUGEPAGE
+    /*Only advice; if transparent huge pages are disabled the block simply stays on ordinary pages*/
+    madvise(aligned, length, MADV_HUGEPAGE);
+#endif
+
+    return aligned;
+}
+
+void freePages(void * memory, size_t bytes, bool hugePages) {
+    if (!memory || bytes == 0) {
+        return;
+    }
+
+    munmap(memory, mappedLength(bytes, hugePages));
+}
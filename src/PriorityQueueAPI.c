@@ -0,0 +1,315 @@
+/**
+ * @file PriorityQueueAPI.c
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Function implementations for an array backed 4-ary heap priority queue
+ **/
+
+#include "PriorityQueueAPI.h"
+
+/*Places an entry at the given index of the heap and records its new position*/
+static void placeEntry(PriorityQueue * pQueue, size_t index, PQEntry entry) {
+    pQueue->heap[index] = entry;
+    pQueue->positions[entry.handle] = index;
+}
+
+static void siftUp(PriorityQueue * pQueue, size_t index) {
+    PQEntry entry = pQueue->heap[index];
+
+    while (index > 0) {
+        size_t parent = (index - 1) / PQ_ARITY;
+        if (pQueue->compareData(entry.data, pQueue->heap[parent].data) >= 0) {
+            break;
+        }
+        placeEntry(pQueue, index, pQueue->heap[parent]);
+        index = parent;
+    }
+
+    placeEntry(pQueue, index, entry);
+}
+
+static void siftDown(PriorityQueue * pQueue, size_t index) {
+    PQEntry entry = pQueue->heap[index];
+
+    while (true) {
+        size_t first = index * PQ_ARITY + 1;
+        if (first >= pQueue->length) {
+            break;
+        }
+
+        /*All children of a node sit next to each other, so finding the lowest touches one or two cache lines*/
+        size_t last = first + PQ_ARITY < pQueue->length ? first + PQ_ARITY : pQueue->length;
+        size_t lowest = first;
+        for (size_t i = first + 1; i < last; ++i) {
+            if (pQueue->compareData(pQueue->heap[i].data, pQueue->heap[lowest].data) < 0) {
+                lowest = i;
+            }
+        }
+
+        if (pQueue->compareData(pQueue->heap[lowest].data, entry.data) >= 0) {
+            break;
+        }
+        placeEntry(pQueue, index, pQueue->heap[lowest]);
+        index = lowest;
+    }
+
+    placeEntry(pQueue, index, entry);
+}
+
+static int growPriorityQueue(PriorityQueue * pQueue, size_t capacity) {
+    if (capacity <= pQueue->capacity) {
+        return EXIT_SUCCESS;
+    }
+
+    PQEntry * heap = realloc(pQueue->heap, sizeof(PQEntry) * capacity);
+    if (!heap) {
+        return EXIT_FAILURE;
+    }
+    pQueue->heap = heap;
+
+    size_t * positions = realloc(pQueue->positions, sizeof(size_t) * capacity);
+    if (!positions) {
+        return EXIT_FAILURE;
+    }
+    pQueue->positions = positions;
+
+    PQHandle * freeHandles = realloc(pQueue->freeHandles, sizeof(PQHandle) * capacity);
+    if (!freeHandles) {
+        return EXIT_FAILURE;
+    }
+    pQueue->freeHandles = freeHandles;
+
+    pQueue->capacity = capacity;
+
+    return EXIT_SUCCESS;
+}
+
+static PQHandle issueHandle(PriorityQueue * pQueue) {
+    if (pQueue->freeCount > 0) {
+        return pQueue->freeHandles[--pQueue->freeCount];
+    }
+
+    return pQueue->handleCount++;
+}
+
+static void releaseHandle(PriorityQueue * pQueue, PQHandle handle) {
+    pQueue->positions[handle] = PQ_INVALID_HANDLE;
+    pQueue->freeHandles[pQueue->freeCount++] = handle;
+}
+
+static bool isValidHandle(PriorityQueue * pQueue, PQHandle handle) {
+    return handle < pQueue->handleCount && pQueue->positions[handle] != PQ_INVALID_HANDLE;
+}
+
+/*Removes the entry at the given index and returns its data without destroying it*/
+static void * removeAt(PriorityQueue * pQueue, size_t index) {
+    PQEntry removed = pQueue->heap[index];
+    releaseHandle(pQueue, removed.handle);
+    pQueue->length--;
+
+    if (index == pQueue->length) {
+        return removed.data;
+    }
+
+    PQEntry last = pQueue->heap[pQueue->length];
+    placeEntry(pQueue, index, last);
+
+    if (index > 0 && pQueue->compareData(last.data, pQueue->heap[(index - 1) / PQ_ARITY].data) < 0) {
+        siftUp(pQueue, index);
+    } else {
+        siftDown(pQueue, index);
+    }
+
+    return removed.data;
+}
+
+PriorityQueue * createPriorityQueue(size_t capacity, char * (*printData)(void * data), void (*destroyData)(void * data), int (*compareData)(const void * a, const void * b)) {
+    PriorityQueue * pQueue = malloc(sizeof(PriorityQueue));
+    if (!pQueue) {
+        return NULL;
+    }
+
+    assert(printData);
+    assert(destroyData);
+    assert(compareData);
+
+    pQueue->heap = NULL;
+    pQueue->positions = NULL;
+    pQueue->freeHandles = NULL;
+    pQueue->length = 0;
+    pQueue->capacity = 0;
+    pQueue->handleCount = 0;
+    pQueue->freeCount = 0;
+    pQueue->printData = printData;
+    pQueue->destroyData = destroyData;
+    pQueue->compareData = compareData;
+
+    if (growPriorityQueue(pQueue, capacity > 0 ? capacity : 16) != EXIT_SUCCESS) {
+        free(pQueue->heap);
+        free(pQueue->positions);
+        free(pQueue->freeHandles);
+        free(pQueue);
+        return NULL;
+    }
+
+    return pQueue;
+}
+
+PriorityQueue * heapifyPriorityQueue(void ** array, size_t length, char * (*printData)(void * data), void (*destroyData)(void * data), int (*compareData)(const void * a, const void * b)) {
+    if (!array && length > 0) {
+        return NULL;
+    }
+
+    PriorityQueue * pQueue = createPriorityQueue(length, printData, destroyData, compareData);
+    if (!pQueue) {
+        return NULL;
+    }
+
+    for (size_t i = 0; i < length; ++i) {
+        pQueue->heap[i].data = array[i];
+        pQueue->heap[i].handle = i;
+        pQueue->positions[i] = i;
+    }
+    pQueue->length = length;
+    pQueue->handleCount = length;
+
+    /*Sift down every internal node from the last one up; this is O(n) overall*/
+    if (length > 1) {
+        size_t i = (length - 2) / PQ_ARITY + 1;
+        while (i-- > 0) {
+            siftDown(pQueue, i);
+        }
+    }
+
+    return pQueue;
+}
+
+int pushPriorityQueue(PriorityQueue * pQueue, void * data, PQHandle * handle) {
+    if (handle) {
+        *handle = PQ_INVALID_HANDLE;
+    }
+
+    if (!pQueue) {
+        return EXIT_FAILURE;
+    }
+
+    if (pQueue->length == pQueue->capacity && growPriorityQueue(pQueue, pQueue->capacity * 2) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    PQEntry entry;
+    entry.data = data;
+    entry.handle = issueHandle(pQueue);
+
+    placeEntry(pQueue, pQueue->length, entry);
+    pQueue->length++;
+    siftUp(pQueue, pQueue->length - 1);
+
+    if (handle) {
+        *handle = entry.handle;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+void * peekPriorityQueue(PriorityQueue * pQueue) {
+    if (!pQueue || pQueue->length == 0) {
+        return NULL;
+    }
+
+    return pQueue->heap[0].data;
+}
+
+void * popPriorityQueue(PriorityQueue * pQueue) {
+    if (!pQueue || pQueue->length == 0) {
+        return NULL;
+    }
+
+    return removeAt(pQueue, 0);
+}
+
+int decreaseKey(PriorityQueue * pQueue, PQHandle handle, void * data) {
+    if (!pQueue || !isValidHandle(pQueue, handle)) {
+        return EXIT_FAILURE;
+    }
+
+    size_t index = pQueue->positions[handle];
+
+    if (data && data != pQueue->heap[index].data) {
+        pQueue->destroyData(pQueue->heap[index].data);
+        pQueue->heap[index].data = data;
+    }
+
+    siftUp(pQueue, index);
+
+    return EXIT_SUCCESS;
+}
+
+int removeHandle(PriorityQueue * pQueue, PQHandle handle) {
+    if (!pQueue || !isValidHandle(pQueue, handle)) {
+        return EXIT_FAILURE;
+    }
+
+    pQueue->destroyData(removeAt(pQueue, pQueue->positions[handle]));
+
+    return EXIT_SUCCESS;
+}
+
+void * getHandleData(PriorityQueue * pQueue, PQHandle handle) {
+    if (!pQueue || !isValidHandle(pQueue, handle)) {
+        return NULL;
+    }
+
+    return pQueue->heap[pQueue->positions[handle]].data;
+}
+
+int destroyPriorityQueue(PriorityQueue * pQueue) {
+    if (!pQueue) {
+        return EXIT_FAILURE;
+    }
+
+    for (size_t i = 0; i < pQueue->length; ++i) {
+        pQueue->destroyData(pQueue->heap[i].data);
+    }
+
+    free(pQueue->heap);
+    pQueue->heap = NULL;
+    free(pQueue->positions);
+    pQueue->positions = NULL;
+    free(pQueue->freeHandles);
+    pQueue->freeHandles = NULL;
+
+    free(pQueue);
+    pQueue = NULL;
+
+    return EXIT_SUCCESS;
+}
+
+char * printPriorityQueue(PriorityQueue * pQueue) {
+    if (!pQueue) {
+        return NULL;
+    }
+
+    char * str = malloc(sizeof(char));
+    if (!str) {
+        return NULL;
+    }
+    strcpy(str, "");
+    char * tempPtr, * tempStr;
+
+    for (size_t i = 0; i < pQueue->length; ++i) {
+        tempStr = pQueue->printData(pQueue->heap[i].data);
+
+        tempPtr = realloc(str, sizeof(char) * (strlen(str) + strlen(tempStr) + 2));
+        if (!tempPtr) {
+            free(str);
+            free(tempStr);
+            return NULL;
+        }
+        str = tempPtr;
+
+        strcat(str, tempStr);
+        free(tempStr);
+    }
+
+    return str;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file ReclamationAPI.c
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Function implementations for destroying data structures on a background thread
+ **/
+
+#include "ReclamationAPI.h"
+
+static once_flag reclamationOnce = ONCE_FLAG_INIT;
+static bool reclamationStarted = false;
+static thrd_t reclamationThread;
+static mtx_t reclamationLock;
+static cnd_t reclamationWake;
+static cnd_t reclamationIdle;
+static ReclamationJob * head = NULL;
+static ReclamationJob * tail = NULL;
+static bool busy = false;
+
+static int runReclamation(void * arg) {
+    (void)arg;
+
+    while (true) {
+        mtx_lock(&reclamationLock);
+        while (!head) {
+            busy = false;
+            cnd_broadcast(&reclamationIdle);
+            cnd_wait(&reclamationWake, &reclamationLock);
+        }
+
+        ReclamationJob * job = head;
+        head = job->next;
+        if (!head) {
+            tail = NULL;
+        }
+        busy = true;
+        mtx_unlock(&reclamationLock);
+
+        job->destroy(job->structure);
+        free(job);
+    }
+
+    return 0;
+}
+
+static void startReclamation(void) {
+    if (mtx_init(&reclamationLock, mtx_plain) != thrd_success) {
+        return;
+    }
+    if (cnd_init(&reclamationWake) != thrd_success) {
+        mtx_destroy(&reclamationLock);
+        return;
+    }
+    if (cnd_init(&reclamationIdle) != thrd_success) {
+        cnd_destroy(&reclamationWake);
+        mtx_destroy(&reclamationLock);
+        return;
+    }
+
+    /*The thread lives for the rest of the process, so nothing ever joins it*/
+    if (thrd_create(&reclamationThread, runReclamation, NULL) != thrd_success) {
+        cnd_destroy(&reclamationIdle);
+        cnd_destroy(&reclamationWake);
+        mtx_destroy(&reclamationLock);
+        return;
+    }
+    thrd_detach(reclamationThread);
+
+    reclamationStarted = true;
+}
+
+int deferReclamation(int (*destroy)(void * structure), void * structure) {
+    if (!destroy || !structure) {
+        return EXIT_FAILURE;
+    }
+
+    call_once(&reclamationOnce, startReclamation);
+
+    ReclamationJob * job = reclamationStarted ? malloc(sizeof(ReclamationJob)) : NULL;
+    if (!job) {
+        return destroy(structure);
+    }
+
+    job->destroy = destroy;
+    job->structure = structure;
+    job->next = NULL;
+
+    mtx_lock(&reclamationLock);
+    if (tail) {
+        tail->next = job;
+    } else {
+        head = job;
+    }
+    tail = job;
+    busy = true;
+    cnd_signal(&reclamationWake);
+    mtx_unlock(&reclamationLock);
+
+    return EXIT_SUCCESS;
+}
+
+int waitReclamation(void) {
+    call_once(&reclamationOnce, startReclamation);
+
+    if (!reclamationStarted) {
+        return EXIT_SUCCESS;
+    }
+
+    mtx_lock(&reclamationLock);
+    while (head || busy) {
+        cnd_wait(&reclamationIdle, &reclamationLock);
+    }
+    mtx_unlock(&reclamationLock);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,254 @@
+/**
+ * @file ThreadPoolAPI.c
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Function implementations for a work-stealing thread pool
+ **/
+
+#include "ThreadPoolAPI.h"
+
+/*Lets a task that submits more work push onto its own worker's deque without taking the lock*/
+static _Thread_local ThreadPool * workerPool = NULL;
+static _Thread_local size_t workerIndex = 0;
+
+typedef struct WorkerStart {
+    ThreadPool * pool;
+    size_t index;
+} WorkerStart;
+
+static ThreadPoolTask * takeSharedTask(ThreadPool * pool) {
+    ThreadPoolTask * task = pool->head;
+
+    if (task) {
+        pool->head = task->next;
+        if (!pool->head) {
+            pool->tail = NULL;
+        }
+    }
+
+    return task;
+}
+
+/*Tries every other worker's deque once, starting with the next one along*/
+static ThreadPoolTask * stealTask(ThreadPool * pool, size_t index) {
+    for (size_t i = 1; i < pool->threadCount; ++i) {
+        ThreadPoolTask * task = stealWorkDeque(pool->deques[(index + i) % pool->threadCount]);
+        if (task) {
+            return task;
+        }
+    }
+
+    return NULL;
+}
+
+static void completeTask(ThreadPool * pool) {
+    if (atomic_fetch_sub(&pool->pending, 1) == 1) {
+        mtx_lock(&pool->lock);
+        cnd_broadcast(&pool->idle);
+        mtx_unlock(&pool->lock);
+    }
+}
+
+static int runWorker(void * arg) {
+    WorkerStart * start = arg;
+    ThreadPool * pool = start->pool;
+    size_t index = start->index;
+    free(start);
+
+    workerPool = pool;
+    workerIndex = index;
+
+    WorkDeque * own = pool->deques[index];
+
+    while (true) {
+        ThreadPoolTask * task = popWorkDeque(own);
+        if (!task) {
+            task = stealTask(pool, index);
+        }
+
+        if (!task) {
+            mtx_lock(&pool->lock);
+            task = takeSharedTask(pool);
+            if (!task) {
+                if (atomic_load(&pool->shutdown)) {
+                    mtx_unlock(&pool->lock);
+                    break;
+                }
+
+                atomic_fetch_add(&pool->sleeping, 1);
+                cnd_wait(&pool->wake, &pool->lock);
+                atomic_fetch_sub(&pool->sleeping, 1);
+                mtx_unlock(&pool->lock);
+                continue;
+            }
+            mtx_unlock(&pool->lock);
+        }
+
+        task->function(task->arg);
+        free(task);
+        completeTask(pool);
+    }
+
+    workerPool = NULL;
+
+    return 0;
+}
+
+/*Wakes the workers and joins the first 'started' of them; used both on shutdown and on a failed create*/
+static void stopWorkers(ThreadPool * pool, size_t started) {
+    mtx_lock(&pool->lock);
+    atomic_store(&pool->shutdown, true);
+    cnd_broadcast(&pool->wake);
+    mtx_unlock(&pool->lock);
+
+    for (size_t i = 0; i < started; ++i) {
+        thrd_join(pool->threads[i], NULL);
+    }
+}
+
+static void freeThreadPool(ThreadPool * pool) {
+    if (pool->deques) {
+        for (size_t i = 0; i < pool->threadCount; ++i) {
+            if (pool->deques[i]) {
+                destroyWorkDeque(pool->deques[i]);
+            }
+        }
+    }
+
+    free(pool->deques);
+    free(pool->threads);
+    mtx_destroy(&pool->lock);
+    cnd_destroy(&pool->wake);
+    cnd_destroy(&pool->idle);
+    free(pool);
+}
+
+ThreadPool * createThreadPool(size_t threadCount) {
+    if (threadCount == 0) {
+        return NULL;
+    }
+
+    ThreadPool * pool = malloc(sizeof(ThreadPool));
+    if (!pool) {
+        return NULL;
+    }
+
+    pool->threadCount = threadCount;
+    pool->head = NULL;
+    pool->tail = NULL;
+    atomic_init(&pool->pending, 0);
+    atomic_init(&pool->sleeping, 0);
+    atomic_init(&pool->shutdown, false);
+
+    if (mtx_init(&pool->lock, mtx_plain) != thrd_success) {
+        free(pool);
+        return NULL;
+    }
+    if (cnd_init(&pool->wake) != thrd_success) {
+        mtx_destroy(&pool->lock);
+        free(pool);
+        return NULL;
+    }
+    if (cnd_init(&pool->idle) != thrd_success) {
+        cnd_destroy(&pool->wake);
+        mtx_destroy(&pool->lock);
+        free(pool);
+        return NULL;
+    }
+
+    pool->threads = malloc(sizeof(thrd_t) * threadCount);
+    pool->deques = calloc(threadCount, sizeof(WorkDeque *));
+    if (!pool->threads || !pool->deques) {
+        freeThreadPool(pool);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < threadCount; ++i) {
+        pool->deques[i] = createWorkDeque(0);
+        if (!pool->deques[i]) {
+            freeThreadPool(pool);
+            return NULL;
+        }
+    }
+
+    for (size_t i = 0; i < threadCount; ++i) {
+        WorkerStart * start = malloc(sizeof(WorkerStart));
+        if (start) {
+            start->pool = pool;
+            start->index = i;
+        }
+
+        if (!start || thrd_create(&pool->threads[i], runWorker, start) != thrd_success) {
+            free(start);
+            stopWorkers(pool, i);
+            freeThreadPool(pool);
+            return NULL;
+        }
+    }
+
+    return pool;
+}
+
+int submitThreadPool(ThreadPool * pool, void (*function)(void * arg), void * arg) {
+    if (!pool || !function) {
+        return EXIT_FAILURE;
+    }
+
+    ThreadPoolTask * task = malloc(sizeof(ThreadPoolTask));
+    if (!task) {
+        return EXIT_FAILURE;
+    }
+
+    task->function = function;
+    task->arg = arg;
+    task->next = NULL;
+
+    atomic_fetch_add(&pool->pending, 1);
+
+    if (workerPool == pool && pushWorkDeque(pool->deques[workerIndex], task) == EXIT_SUCCESS) {
+        /*The submitting worker will get to the task itself, so a sleeper only needs waking to share the load*/
+        if (atomic_load(&pool->sleeping) > 0) {
+            mtx_lock(&pool->lock);
+            cnd_signal(&pool->wake);
+            mtx_unlock(&pool->lock);
+        }
+        return EXIT_SUCCESS;
+    }
+
+    mtx_lock(&pool->lock);
+    if (pool->tail) {
+        pool->tail->next = task;
+    } else {
+        pool->head = task;
+    }
+    pool->tail = task;
+    cnd_signal(&pool->wake);
+    mtx_unlock(&pool->lock);
+
+    return EXIT_SUCCESS;
+}
+
+int waitThreadPool(ThreadPool * pool) {
+    if (!pool || workerPool == pool) {
+        return EXIT_FAILURE;
+    }
+
+    mtx_lock(&pool->lock);
+    while (atomic_load(&pool->pending) > 0) {
+        cnd_wait(&pool->idle, &pool->lock);
+    }
+    mtx_unlock(&pool->lock);
+
+    return EXIT_SUCCESS;
+}
+
+int destroyThreadPool(ThreadPool * pool) {
+    if (waitThreadPool(pool) != EXIT_SUCCESS) {
+        return EXIT_FAILURE;
+    }
+
+    stopWorkers(pool, pool->threadCount);
+    freeThreadPool(pool);
+    pool = NULL;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,175 @@
+/**
+ * @file WorkDequeAPI.c
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Function implementations for a lock-free Chase-Lev work-stealing deque
+ *
+ * Follows the C11 formulation of the deque given by Le, Pop, Cohen and
+ * Zappa Nardelli in "Correct and Efficient Work-Stealing for Weak Memory Models"
+ **/
+
+#include "WorkDequeAPI.h"
+
+static WorkDequeBuffer * createWorkDequeBuffer(size_t capacity) {
+    WorkDequeBuffer * buffer = malloc(sizeof(WorkDequeBuffer) + sizeof(_Atomic(void *)) * capacity);
+    if (!buffer) {
+        return NULL;
+    }
+
+    buffer->capacity = capacity;
+    buffer->prev = NULL;
+
+    return buffer;
+}
+
+static void * loadSlot(WorkDequeBuffer * buffer, long long index) {
+    return atomic_load_explicit(&buffer->slots[(size_t)index & (buffer->capacity - 1)], memory_order_relaxed);
+}
+
+static void storeSlot(WorkDequeBuffer * buffer, long long index, void * data) {
+    atomic_store_explicit(&buffer->slots[(size_t)index & (buffer->capacity - 1)], data, memory_order_relaxed);
+}
+
+/*Copies the live range into an array twice the size; the old array stays readable for thieves still using it*/
+static WorkDequeBuffer * growWorkDeque(WorkDeque * deque, WorkDequeBuffer * buffer, long long top, long long bottom) {
+    WorkDequeBuffer * grown = createWorkDequeBuffer(buffer->capacity * 2);
+    if (!grown) {
+        return NULL;
+    }
+
+    for (long long i = top; i < bottom; ++i) {
+        storeSlot(grown, i, loadSlot(buffer, i));
+    }
+    grown->prev = buffer;
+
+    atomic_store_explicit(&deque->buffer, grown, memory_order_release);
+
+    return grown;
+}
+
+WorkDeque * createWorkDeque(size_t capacity) {
+    size_t rounded = 16;
+    while (rounded < capacity) {
+        rounded *= 2;
+    }
+
+    WorkDeque * deque = aligned_alloc(WORK_DEQUE_CACHE_LINE, sizeof(WorkDeque));
+    if (!deque) {
+        return NULL;
+    }
+
+    WorkDequeBuffer * buffer = createWorkDequeBuffer(rounded);
+    if (!buffer) {
+        free(deque);
+        return NULL;
+    }
+
+    atomic_init(&deque->top, 0);
+    atomic_init(&deque->bottom, 0);
+    atomic_init(&deque->buffer, buffer);
+
+    return deque;
+}
+
+int pushWorkDeque(WorkDeque * deque, void * data) {
+    if (!deque || !data) {
+        return EXIT_FAILURE;
+    }
+
+    long long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    long long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    WorkDequeBuffer * buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+
+    if (bottom - top > (long long)buffer->capacity - 1) {
+        buffer = growWorkDeque(deque, buffer, top, bottom);
+        if (!buffer) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    storeSlot(buffer, bottom, data);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+
+    return EXIT_SUCCESS;
+}
+
+void * popWorkDeque(WorkDeque * deque) {
+    if (!deque) {
+        return NULL;
+    }
+
+    long long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1;
+    WorkDequeBuffer * buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+    atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    if (top > bottom) {
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+        return NULL;
+    }
+
+    void * data = loadSlot(buffer, bottom);
+
+    /*The last element may also be the target of a thief, so it has to be claimed through 'top'*/
+    if (top == bottom) {
+        if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed)) {
+            data = NULL;
+        }
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed);
+    }
+
+    return data;
+}
+
+void * stealWorkDeque(WorkDeque * deque) {
+    if (!deque) {
+        return NULL;
+    }
+
+    long long top = atomic_load_explicit(&deque->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long long bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire);
+
+    if (top >= bottom) {
+        return NULL;
+    }
+
+    WorkDequeBuffer * buffer = atomic_load_explicit(&deque->buffer, memory_order_acquire);
+    void * data = loadSlot(buffer, top);
+
+    if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed)) {
+        return NULL;
+    }
+
+    return data;
+}
+
+size_t getWorkDequeLength(WorkDeque * deque) {
+    if (!deque) {
+        return 0;
+    }
+
+    long long bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed);
+    long long top = atomic_load_explicit(&deque->top, memory_order_relaxed);
+
+    return bottom > top ? (size_t)(bottom - top) : 0;
+}
+
+int destroyWorkDeque(WorkDeque * deque) {
+    if (!deque) {
+        return EXIT_FAILURE;
+    }
+
+    WorkDequeBuffer * buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed);
+    while (buffer) {
+        WorkDequeBuffer * prev = buffer->prev;
+        free(buffer);
+        buffer = prev;
+    }
+
+    free(deque);
+    deque = NULL;
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file ConcurrentListStress.c
+ * @author Nicholas Domenichini <ndomenic@uoguelph.ca>
+ * @brief Multi-threaded insert/remove/contains stress test for the ConcurrentList
+ *
+ * Every thread hammers a small shared key range so that nodes are constantly
+ * unlinked while others are reading them. Afterwards the list must be sorted,
+ * its 'length' must match its contents, every key must be present exactly when
+ * its successful inserts outnumber its successful removes, and every piece of
+ * data must have been destroyed once the list is. Build with -fsanitize=address
+ * to also catch use after free and leaked nodes
+ **/
+
+#include "ConcurrentListAPI.h"
+
+#include <threads.h>
+#include <time.h>
+
+#define STRESS_THREADS 8
+#define STRESS_KEYS 512
+#define STRESS_OPERATIONS 200000
+
+static atomic_long liveData = 0;
+static atomic_long balance[STRESS_KEYS];
+
+static char * printInt(void * data) {
+    char * str = malloc(sizeof(char) * 16);
+    if (str) {
+        sprintf(str, "%d ", *(int *)data);
+    }
+    return str;
+}
+
+static void destroyInt(void * data) {
+    atomic_fetch_sub(&liveData, 1);
+    free(data);
+}
+
+static int compareInt(const void * a, const void * b) {
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+
+    return (x > y) - (x < y);
+}
+
+typedef struct StressThread {
+    ConcurrentList * list;
+    unsigned int seed;
+} StressThread;
+
+/*xorshift32; rand() is not required to be thread safe*/
+static unsigned int nextRandom(unsigned int * state) {
+    unsigned int x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    return *state = x;
+}
+
+static int runStress(void * arg) {
+    StressThread * thread = arg;
+
+    for (int i = 0; i < STRESS_OPERATIONS; ++i) {
+        unsigned int random = nextRandom(&thread->seed);
+        int key = (int)(random % STRESS_KEYS);
+        unsigned int operation = (random >> 16) % 3;
+
+        if (operation == 0) {
+            int * data = malloc(sizeof(int));
+            if (!data) {
+                return EXIT_FAILURE;
+            }
+            *data = key;
+            atomic_fetch_add(&liveData, 1);
+
+            if (insertConcurrentList(thread->list, data) == EXIT_SUCCESS) {
+                atomic_fetch_add(&balance[key], 1);
+            } else {
+                destroyInt(data);
+            }
+        } else if (operation == 1) {
+            if (removeFromConcurrentList(thread->list, &key) == EXIT_SUCCESS) {
+                atomic_fetch_sub(&balance[key], 1);
+            }
+        } else {
+            concurrentListContains(thread->list, &key);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+static int checkList(ConcurrentList * list) {
+    int failures = 0;
+    size_t count = 0;
+    int previous = -1;
+
+    for (uintptr_t link = atomic_load(&list->head); link; ) {
+        ConcurrentListNode * node = (ConcurrentListNode *)(link & ~(uintptr_t)1);
+        link = atomic_load(&node->next);
+
+        if (link & 1) {
+            fprintf(stderr, "node %d is still marked as removed\n", *(int *)node->data);
+            failures++;
+        }
+        if (*(int *)node->data <= previous) {
+            fprintf(stderr, "node %d follows %d\n", *(int *)node->data, previous);
+            failures++;
+        }
+        previous = *(int *)node->data;
+        count++;
+    }
+
+    if (count != atomic_load(&list->length)) {
+        fprintf(stderr, "list holds %zu nodes but its length is %zu\n", count, atomic_load(&list->length));
+        failures++;
+    }
+
+    for (int key = 0; key < STRESS_KEYS; ++key) {
+        long expected = atomic_load(&balance[key]);
+        bool found = concurrentListContains(list, &key);
+
+        if (expected < 0 || expected > 1 || found != (expected == 1)) {
+            fprintf(stderr, "key %d: %ld more inserts than removes, but contains says %s\n", key, expected, found ? "true" : "false");
+            failures++;
+        }
+    }
+
+    return failures;
+}
+
+int main(void) {
+    ConcurrentList * list = createConcurrentList(printInt, destroyInt, compareInt);
+    if (!list) {
+        return EXIT_FAILURE;
+    }
+
+    thrd_t threads[STRESS_THREADS];
+    StressThread args[STRESS_THREADS];
+
+    /*Staggered starts keep new hazard records appearing while earlier threads are already scanning theirs*/
+    for (int i = 0; i < STRESS_THREADS; ++i) {
+        thrd_sleep(&(struct timespec){ .tv_nsec = 2000000 }, NULL);
+        args[i].list = list;
+        args[i].seed = 2463534242u + (unsigned int)i * 7919u;
+        if (thrd_create(&threads[i], runStress, &args[i]) != thrd_success) {
+            fprintf(stderr, "could not start thread %d\n", i);
+            return EXIT_FAILURE;
+        }
+    }
+
+    int failures = 0;
+    for (int i = 0; i < STRESS_THREADS; ++i) {
+        int result;
+        thrd_join(threads[i], &result);
+        if (result != EXIT_SUCCESS) {
+            failures++;
+        }
+    }
+
+    failures += checkList(list);
+    size_t length = atomic_load(&list->length);
+
+    destroyConcurrentList(list);
+
+    if (atomic_load(&liveData) != 0) {
+        fprintf(stderr, "%ld pieces of data were never destroyed\n", atomic_load(&liveData));
+        failures++;
+    }
+
+    printf("%d threads x %d operations over %d keys: %zu left, %s\n", STRESS_THREADS, STRESS_OPERATIONS, STRESS_KEYS, length, failures ? "FAILED" : "passed");
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}